@@ -56,6 +56,9 @@ class MUIU8G2
     void begin(U8G2 &u8g2, fds_t *fds, muif_t *muif_list, size_t muif_cnt) {
       mui_Init(&mui, (void *)u8g2.getU8g2(), fds, muif_list, muif_cnt);
     }
+    void begin(U8G2 &u8g2, fds_t *fds, muif_t *muif_list, size_t muif_cnt, mui_index_t *index) {
+      mui_InitWithIndex(&mui, (void *)u8g2.getU8g2(), fds, muif_list, muif_cnt, index);
+    }
     mui_t *getMUI(void) { return &mui; }
 
     uint8_t getCurrentCursorFocusPosition(void) { return mui_GetCurrentCursorFocusPosition(&mui); }
@@ -64,6 +67,10 @@ class MUIU8G2
 
     
     void draw(void) { mui_Draw(&mui); }
+    void setRedraw(mui_redraw_t *redraw) { mui_SetRedraw(&mui, redraw, mui_u8g2_redraw_cb); }
+    void markDirtyAll(void) { mui_MarkDirtyAll(&mui); }
+    void drawDirty(void) { mui_DrawDirty(&mui); }
+    void updateDirtyArea(void) { mui_u8g2_UpdateDirtyArea(&mui); }
     //void getSelectableFieldTextOption(fds_t *fds, uint8_t nth_token)
     //  { mui_GetSelectableFieldTextOption(&mui, fds, nth_token); }      
     void enterForm(fds_t *fds, uint8_t initial_cursor_position) { mui_EnterForm(&mui, fds, initial_cursor_position); }
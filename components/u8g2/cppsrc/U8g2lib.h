@@ -194,6 +194,17 @@ class U8G2
     void setBufferPtr(uint8_t *buf) { u8g2_SetBufferPtr(&u8g2, buf); }
     uint16_t getBufferSize() { return u8g2_GetBufferSize(&u8g2); }
     #endif
+    uint8_t setBuffers(uint8_t **buf_list, uint8_t cnt) { return u8g2_SetBuffers(&u8g2, buf_list, cnt); }
+    uint8_t *nextBuffer(void) { return u8g2_NextBuffer(&u8g2); }
+    void fillBuffer(const uint8_t *pattern) { u8g2_FillBuffer(&u8g2, pattern); }
+    void fillBufferBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *pattern)
+      { u8g2_FillBufferBox(&u8g2, x, y, w, h, pattern); }
+    void clearBufferBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+      { u8g2_ClearBufferBox(&u8g2, x, y, w, h); }
+    void invertBufferBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+      { u8g2_InvertBufferBox(&u8g2, x, y, w, h); }
+    void ditherBufferBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t level)
+      { u8g2_DitherBufferBox(&u8g2, x, y, w, h, level); }
     uint8_t *getBufferPtr(void) { return u8g2_GetBufferPtr(&u8g2); }
     uint8_t getBufferTileHeight(void) { return u8g2_GetBufferTileHeight(&u8g2); }
     uint8_t getBufferTileWidth(void) { return u8g2_GetBufferTileWidth(&u8g2); }
@@ -211,6 +222,9 @@ class U8G2
       { u8g2_UpdateDisplay(&u8g2); }
     void refreshDisplay(void)
       { u8x8_RefreshDisplay(u8g2_GetU8x8(&u8g2)); }
+
+    /* u8g2_epd.c */
+    uint8_t sendBuffer(u8g2_epd_t *epd) { return u8g2_epd_SendBuffer(&u8g2, epd); }
     
 
 
@@ -296,6 +310,9 @@ u8g2_uint_t u8g2_GetUTF8Width(u8g2_t *u8g2, const char *str);
     u8g2_uint_t drawStrX2(u8g2_uint_t x, u8g2_uint_t y, const char *s) { return u8g2_DrawStrX2(&u8g2, x, y, s); }
     u8g2_uint_t drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char *s) { return u8g2_DrawUTF8(&u8g2, x, y, s); }
     u8g2_uint_t drawUTF8X2(u8g2_uint_t x, u8g2_uint_t y, const char *s) { return u8g2_DrawUTF8X2(&u8g2, x, y, s); }
+    u8g2_uint_t drawGlyphScaled(u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, uint16_t encoding) { return u8g2_DrawGlyphScaled(&u8g2, x, y, scale, encoding); }
+    u8g2_uint_t drawStrScaled(u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *s) { return u8g2_DrawStrScaled(&u8g2, x, y, scale, s); }
+    u8g2_uint_t drawUTF8Scaled(u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *s) { return u8g2_DrawUTF8Scaled(&u8g2, x, y, scale, s); }
     u8g2_uint_t drawExtUTF8(u8g2_uint_t x, u8g2_uint_t y, uint8_t to_left, const uint16_t *kerning_table, const char *s) 
       { return u8g2_DrawExtUTF8(&u8g2, x, y, to_left, kerning_table, s); }
 
@@ -464,6 +481,10 @@ class U8G2LOG
     void writeHex32(uint32_t v) { u8log_WriteHex32(&u8log, v); }
     void writeDec8(uint8_t v, uint8_t d) { u8log_WriteDec8(&u8log, v, d); }
     void writeDec16(uint8_t v, uint8_t d) { u8log_WriteDec16(&u8log, v, d); }    
+
+    /* lock free producer queues, filled by other tasks or interrupts, see u8log_queue.c */
+    void addQueue(u8log_queue_t *queue) { u8log_AddQueue(&u8log, queue); }
+    uint16_t drainQueues(void) { return u8log_DrainQueues(&u8log); }
 };
 
 /* u8log_u8g2.c */
@@ -312,6 +312,15 @@ class U8X8
 
     void draw1x2UTF8(uint8_t x, uint8_t y, const char *s) {
       u8x8_Draw1x2UTF8(&u8x8, x, y, s); }
+
+    void drawScaledGlyph(uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, uint8_t encoding) {
+      u8x8_DrawScaledGlyph(&u8x8, x, y, sx, sy, encoding); }
+
+    void drawScaledString(uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, const char *s) {
+      u8x8_DrawScaledString(&u8x8, x, y, sx, sy, s); }
+
+    void drawScaledUTF8(uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, const char *s) {
+      u8x8_DrawScaledUTF8(&u8x8, x, y, sx, sy, s); }
       
     uint8_t getUTF8Len(const char *s) {
       return u8x8_GetUTF8Len(&u8x8, s); }
@@ -413,6 +422,10 @@ class U8X8LOG
     void writeHex32(uint32_t v) { u8log_WriteHex32(&u8log, v); }
     void writeDec8(uint8_t v, uint8_t d) { u8log_WriteDec8(&u8log, v, d); }
     void writeDec16(uint8_t v, uint8_t d) { u8log_WriteDec16(&u8log, v, d); }    
+
+    /* lock free producer queues, filled by other tasks or interrupts, see u8log_queue.c */
+    void addQueue(u8log_queue_t *queue) { u8log_AddQueue(&u8log, queue); }
+    uint16_t drainQueues(void) { return u8log_DrainQueues(&u8log); }
 };
 
 
@@ -301,9 +301,104 @@ void mui_Init(mui_t *ui, void *graphics_data, fds_t *fds, muif_t *muif_tlist, si
   ui->last_form_stack_pos = -1;
 }
 
+
+/*=== optional index ===*/
+
+#define mui_index_get_key(id0, id1) ((((uint16_t)(id0))<<8) | (uint16_t)(id1))
+#define mui_index_get_muif_key(ui, i) mui_index_get_key(muif_get_id0((ui)->muif_tlist+(i)), muif_get_id1((ui)->muif_tlist+(i)))
+#define mui_index_is_selectable(f) ((f)->uif != NULL && (muif_get_cflags((f)->uif) & MUIF_CFLAG_IS_CURSOR_SELECTABLE))
+
+/* marks a form with more than MUI_INDEX_MAX_FIELDS fields */
+#define MUI_INDEX_FIELD_OVERFLOW 255
+
+/*
+  build the form table and the sorted muif list
+  the form table points to the first form with a given id, the muif list is sorted stable,
+  so both lookups return the same result as the linear search
+*/
+static void mui_index_build(mui_t *ui)
+{
+  mui_index_t *index = ui->index;
+  fds_t *fds = ui->root_fds;
+  uint8_t cmd, id;
+  uint16_t i, j, pos, key;
+  
+  memset(index, 0, sizeof(mui_index_t));
+  
+  for( ;; )
+  {
+    cmd = mui_get_fds_char(fds);
+    if ( cmd == 0 )
+      break;
+    if ( cmd == 'U' )
+    {
+      id = mui_get_fds_char(fds+1);
+      if ( index->form_fds[id] == NULL )
+        index->form_fds[id] = fds;
+    }
+    fds += mui_fds_get_cmd_size(ui, fds);
+  }
+  
+  if ( ui->muif_tcnt > MUI_INDEX_MAX_MUIF )
+    return;     /* too many entries, use linear search */
+  
+  /* insertion sort, only executed once */
+  for( i = 0; i < ui->muif_tcnt; i++ )
+  {
+    key = mui_index_get_muif_key(ui, i);
+    j = i;
+    while( j > 0 )
+    {
+      pos = index->muif_sorted[j-1];
+      if ( mui_index_get_muif_key(ui, pos) <= key )
+        break;
+      index->muif_sorted[j] = pos;
+      j--;
+    }
+    index->muif_sorted[j] = i;
+  }
+  index->muif_cnt = ui->muif_tcnt;
+}
+
+static int mui_index_find_uif(mui_t *ui, uint8_t id0, uint8_t id1)
+{
+  mui_index_t *index = ui->index;
+  uint16_t key = mui_index_get_key(id0, id1);
+  uint16_t lo = 0;
+  uint16_t hi = index->muif_cnt;
+  uint16_t mid;
+  
+  /* lower bound: first entry with the key */
+  while( lo < hi )
+  {
+    mid = (lo + hi) / 2;
+    if ( mui_index_get_muif_key(ui, index->muif_sorted[mid]) < key )
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if ( lo < index->muif_cnt && mui_index_get_muif_key(ui, index->muif_sorted[lo]) == key )
+    return index->muif_sorted[lo];
+  return -1;
+}
+
+/*
+  Same as mui_Init(), but builds an index for the forms and the muif list.
+  Form changes, field lookup and cursor movement will not scan the FDS again.
+  "index" must be available as long as "ui" is used.
+*/
+void mui_InitWithIndex(mui_t *ui, void *graphics_data, fds_t *fds, muif_t *muif_tlist, size_t muif_tcnt, mui_index_t *index)
+{
+  mui_Init(ui, graphics_data, fds, muif_tlist, muif_tcnt);
+  ui->index = index;
+  mui_index_build(ui);
+}
+
 static int mui_find_uif(mui_t *ui, uint8_t id0, uint8_t id1)
 {
   size_t i;
+  if ( ui->index != NULL && ui->index->muif_cnt > 0 )
+    return mui_index_find_uif(ui, id0, id1);
   for( i = 0; i < ui->muif_tcnt; i++ )
   {
     /*
@@ -326,22 +421,13 @@ static int mui_find_uif(mui_t *ui, uint8_t id0, uint8_t id1)
   will return 1 if the field id was found.
   will return 0 if the field id was not found in uif or if ui->fds points to something else than a field
 */
-static uint8_t mui_prepare_current_field(mui_t *ui) MUI_NOINLINE;
-static uint8_t mui_prepare_current_field(mui_t *ui)
+/* 
+  second part of mui_prepare_current_field(): cmd, dflags, id0, id1, x, y and arg
+  returns 0 for the end of the form
+*/
+static uint8_t mui_prepare_current_field_args(mui_t *ui) MUI_NOINLINE;
+static uint8_t mui_prepare_current_field_args(mui_t *ui)
 {
-  int muif_tidx;
-
-  ui->uif = NULL;
-  ui->dflags = 0;    
-  ui->id0 = 0;
-  ui->id1 = 0;
-  ui->arg = 0;
-
-  /* calculate the length of the command and copy the text argument */
-  /* this will also clear the text in cases where there is no text argument */
-  ui->len = mui_fds_get_cmd_size(ui, ui->fds); 
-  //printf("mui_prepare_current_field len=%d\n", ui->len);
-
   /* get the command and check whether end of form is reached */
   ui->cmd = mui_get_fds_char(ui->fds);
   //printf("mui_prepare_current_field cmd='%c' len=%d\n", ui->cmd, ui->len);
@@ -397,7 +483,27 @@ static uint8_t mui_prepare_current_field(mui_t *ui)
   }
 
   //MUI_DEBUG("mui_prepare_current_field cmd='%c' len=%d arg=%d\n", ui->cmd, ui->len, ui->arg);
+  return 1;
+}
+
+static uint8_t mui_prepare_current_field(mui_t *ui) MUI_NOINLINE;
+static uint8_t mui_prepare_current_field(mui_t *ui)
+{
+  int muif_tidx;
+
+  ui->uif = NULL;
+  ui->dflags = 0;    
+  ui->id0 = 0;
+  ui->id1 = 0;
+  ui->arg = 0;
 
+  /* calculate the length of the command and copy the text argument */
+  /* this will also clear the text in cases where there is no text argument */
+  ui->len = mui_fds_get_cmd_size(ui, ui->fds); 
+  //printf("mui_prepare_current_field len=%d\n", ui->len);
+
+  if ( mui_prepare_current_field_args(ui) == 0 )
+    return 0;
   
   /* find the field  */
   muif_tidx = mui_find_uif(ui, ui->id0, ui->id1);
@@ -445,6 +551,165 @@ static void mui_inner_loop_over_form(mui_t *ui, uint8_t (*task)(mui_t *ui))
   //MUI_DEBUG("mui_inner_loop_over_form end %p\n", task);
 }
 
+/*
+  returns 1 if the field cache for the current form is available
+  the cache is rebuilt if the current form has changed
+*/
+static uint8_t mui_index_prepare_fields(mui_t *ui) MUI_NOINLINE;
+static uint8_t mui_index_prepare_fields(mui_t *ui)
+{
+  mui_index_t *index = ui->index;
+  fds_t *fds;
+  uint8_t cmd;
+  uint8_t cnt = 0;
+  
+  if ( index == NULL || ui->current_form_fds == NULL )
+    return 0;
+  if ( index->field_form_fds == ui->current_form_fds )
+    return index->field_cnt != MUI_INDEX_FIELD_OVERFLOW;
+  
+  fds = ui->current_form_fds;
+  fds += mui_fds_get_cmd_size(ui, fds);      // skip the first entry, it is U always
+  for(;;)
+  {
+    cmd = mui_get_fds_char(fds);
+    if ( cmd == 'U' || cmd == 0 )
+      break;
+    if ( cnt >= MUI_INDEX_MAX_FIELDS )
+    {
+      cnt = MUI_INDEX_FIELD_OVERFLOW;
+      break;
+    }
+    ui->fds = fds;
+    mui_prepare_current_field(ui);  /* calculates ui->len, ui->text and ui->uif */
+    index->field[cnt].fds = fds;
+    index->field[cnt].uif = ui->uif;
+    index->field[cnt].len = ui->len;
+    index->field[cnt].text_pos = 0;
+    index->field[cnt].text_len = strlen(ui->text);
+    if ( mui_fds_is_text(cmd) )
+      index->field[cnt].text_pos = mui_fds_get_cmd_size_without_text(fds);
+    cnt++;
+    fds += ui->len;
+  }
+  index->field_form_fds = ui->current_form_fds;
+  index->field_cnt = cnt;
+  index->cursor_field_idx = 0;
+  return cnt != MUI_INDEX_FIELD_OVERFLOW;
+}
+
+/* same as mui_prepare_current_field(), but the size, text and muif are taken from the field cache */
+static uint8_t mui_index_prepare_field(mui_t *ui, mui_index_field_t *field)
+{
+  fds_t *t;
+  uint8_t i;
+
+  ui->fds = field->fds;
+  ui->uif = NULL;
+  ui->dflags = 0;    
+  ui->id0 = 0;
+  ui->id1 = 0;
+  ui->arg = 0;
+  ui->len = field->len;
+  if ( field->text_pos != 0 )
+  {
+    t = field->fds + field->text_pos;
+    ui->delimiter = mui_get_fds_char(t);
+    t++;
+    for( i = 0; i < field->text_len; i++ )
+      ui->text[i] = mui_get_fds_char(t+i);
+  }
+  ui->text[field->text_len] = '\0';
+  if ( mui_prepare_current_field_args(ui) == 0 )
+    return 0;
+  ui->uif = field->uif;
+  return ui->uif != NULL;
+}
+
+/* same as mui_inner_loop_over_form, but without parsing the form again */
+static void mui_index_loop_over_fields(mui_t *ui, uint8_t (*task)(mui_t *ui))
+{
+  mui_index_t *index = ui->index;
+  fds_t *form_fds = index->field_form_fds;
+  uint8_t i;
+  
+  for( i = 0; i < index->field_cnt; i++ )
+  {
+    if ( index->field[i].uif == NULL )
+      continue;
+    if ( mui_index_prepare_field(ui, index->field+i) )
+      if ( task(ui) )
+        break;
+    if ( index->field_form_fds != form_fds )
+      break;    /* the form has been changed by the task */
+  }
+}
+
+/* returns the position of the cursor focus field in the field cache or field_cnt if there is no selectable focus field */
+static uint8_t mui_index_get_cursor_field(mui_t *ui)
+{
+  mui_index_t *index = ui->index;
+  uint8_t i = index->cursor_field_idx;
+  
+  if ( i >= index->field_cnt || index->field[i].fds != ui->cursor_focus_fds )
+  {
+    for( i = 0; i < index->field_cnt; i++ )
+      if ( index->field[i].fds == ui->cursor_focus_fds )
+        break;
+  }
+  if ( i < index->field_cnt && mui_index_is_selectable(index->field+i) )
+  {
+    index->cursor_field_idx = i;
+    return i;
+  }
+  return index->field_cnt;
+}
+
+/* dir: 1 next, 0 previous, result is stored in ui->target_fds */
+static void mui_index_find_cursor_field(mui_t *ui, uint8_t is_next)
+{
+  mui_index_t *index = ui->index;
+  uint8_t cnt = index->field_cnt;
+  uint8_t cur = mui_index_get_cursor_field(ui);
+  uint8_t i;
+  
+  ui->target_fds = NULL;
+  if ( cnt == 0 )
+    return;
+  if ( is_next )
+  {
+    i = cur;
+    if ( cur < cnt )
+      for( i = cur+1; i < cnt; i++ )
+        if ( mui_index_is_selectable(index->field+i) )
+          break;
+    if ( i >= cnt )     /* no next field, start with the first field */
+      for( i = 0; i < cnt; i++ )
+        if ( mui_index_is_selectable(index->field+i) )
+          break;
+  }
+  else
+  {
+    i = cnt;
+    if ( cur < cnt )
+      for( i = cur; i > 0; i-- )
+        if ( mui_index_is_selectable(index->field+i-1) )
+          break;
+    if ( i == 0 || i >= cnt )     /* no previous field, continue with the last field */
+      for( i = cnt; i > 0; i-- )
+        if ( mui_index_is_selectable(index->field+i-1) )
+          break;
+    if ( i == 0 )
+      return;
+    i--;
+  }
+  if ( i < cnt )
+  {
+    ui->target_fds = index->field[i].fds;
+    index->cursor_field_idx = i;
+  }
+}
+
 static void mui_loop_over_form(mui_t *ui, uint8_t (*task)(mui_t *ui)) MUI_NOINLINE;
 static void mui_loop_over_form(mui_t *ui, uint8_t (*task)(mui_t *ui))
 {
@@ -455,6 +720,11 @@ static void mui_loop_over_form(mui_t *ui, uint8_t (*task)(mui_t *ui))
   ui->target_fds = NULL;
   ui->tmp_fds = NULL;
   
+  if ( mui_index_prepare_fields(ui) )
+  {
+    mui_index_loop_over_fields(ui, task);
+    return;
+  }
   mui_inner_loop_over_form(ui, task);  
 }
 
@@ -466,6 +736,9 @@ static fds_t *mui_find_form(mui_t *ui, uint8_t n)
   fds_t *fds = ui->root_fds;
   uint8_t cmd;
   
+  if ( ui->index != NULL )
+    return ui->index->form_fds[n];
+  
   for( ;; )
   {
     cmd = mui_get_fds_char(fds);
@@ -613,6 +886,182 @@ static uint8_t mui_task_find_execute_on_select_field(mui_t *ui)
 }
 
 
+/* === optional partial redraw === */
+
+static void mui_redraw_mark_all(mui_t *ui)
+{
+  if ( ui->redraw != NULL )
+  {
+    ui->redraw->is_all = 1;
+    ui->redraw->dirty_cnt = 0;
+  }
+}
+
+static void mui_redraw_mark_field(mui_t *ui, fds_t *fds)
+{
+  mui_redraw_t *r = ui->redraw;
+  uint8_t i;
+  if ( r == NULL || fds == NULL || r->is_all )
+    return;
+  for( i = 0; i < r->dirty_cnt; i++ )
+    if ( r->dirty_fds[i] == fds )
+      return;
+  if ( r->dirty_cnt >= MUI_REDRAW_MAX_DIRTY )
+  {
+    mui_redraw_mark_all(ui);  /* too many changes, draw everything */
+    return;
+  }
+  r->dirty_fds[r->dirty_cnt++] = fds;
+}
+
+static mui_field_box_t *mui_redraw_find_field_box(mui_redraw_t *r, fds_t *fds)
+{
+  uint8_t i;
+  for( i = 0; i < r->box_cnt; i++ )
+    if ( r->field_box[i].fds == fds )
+      return r->field_box+i;
+  return NULL;
+}
+
+static uint8_t mui_redraw_is_overlap(mui_box_t *a, mui_box_t *b)
+{
+  return a->x0 < b->x1 && b->x0 < a->x1 && a->y0 < b->y1 && b->y0 < a->y1;
+}
+
+static uint8_t mui_redraw_is_inside(mui_box_t *inner, mui_box_t *outer)
+{
+  return outer->x0 <= inner->x0 && inner->x1 <= outer->x1 && outer->y0 <= inner->y0 && inner->y1 <= outer->y1;
+}
+
+/* extend box "a" so that it also includes box "b", empty boxes are ignored */
+static void mui_redraw_union(mui_box_t *a, mui_box_t *b)
+{
+  if ( b->x0 >= b->x1 || b->y0 >= b->y1 )
+    return;
+  if ( a->x0 >= a->x1 )
+  {
+    *a = *b;
+    return;
+  }
+  if ( a->x0 > b->x0 ) a->x0 = b->x0;
+  if ( a->y0 > b->y0 ) a->y0 = b->y0;
+  if ( a->x1 < b->x1 ) a->x1 = b->x1;
+  if ( a->y1 < b->y1 ) a->y1 = b->y1;
+}
+
+/* extend the modified area, empty boxes are ignored */
+static void mui_redraw_extend_area(mui_redraw_t *r, mui_box_t *b)
+{
+  mui_redraw_union(&(r->area), b);
+}
+
+/*
+  Grow the clear boxes until each field box, which overlaps with a clear box, is completely inside that clear box.
+  Fields are always repainted completely, so a field must not be drawn on top of its own old content:
+  Inverted (XOR) output would be inverted twice.
+*/
+static void mui_redraw_grow_clear_boxes(mui_redraw_t *r)
+{
+  mui_box_t *fbox;
+  uint8_t i, j;
+  uint8_t is_changed;
+  do
+  {
+    is_changed = 0;
+    for( i = 0; i < r->clear_cnt; i++ )
+      for( j = 0; j < r->box_cnt; j++ )
+      {
+        fbox = &(r->field_box[j].box);
+        if ( fbox->x0 >= fbox->x1 )
+          continue;
+        if ( mui_redraw_is_overlap(fbox, r->clear_box+i) && mui_redraw_is_inside(fbox, r->clear_box+i) == 0 )
+        {
+          mui_redraw_union(r->clear_box+i, fbox);
+          is_changed = 1;
+        }
+      }
+  } while( is_changed );
+}
+
+/* 
+  draw the current field and measure the drawn area, fb can be NULL 
+  is_extend: 0 if the field is unchanged and only repaints the cleared area, which is already part of the modified area
+*/
+static void mui_redraw_draw_field(mui_t *ui, mui_field_box_t *fb, uint8_t is_extend)
+{
+  mui_redraw_t *r = ui->redraw;
+  mui_box_t box;
+  r->cb(ui, MUI_REDRAW_MSG_START, &box);
+  muif_get_cb(ui->uif)(ui, MUIF_MSG_DRAW);
+  r->cb(ui, MUI_REDRAW_MSG_END, &box);
+  if ( is_extend )
+    mui_redraw_extend_area(r, &box);
+  if ( fb != NULL )
+    fb->box = box;
+}
+
+/* draw all fields and store the area of each field */
+static uint8_t mui_task_redraw_all(mui_t *ui)
+{
+  mui_redraw_t *r = ui->redraw;
+  mui_field_box_t *fb = NULL;
+  if ( r->box_cnt < MUI_REDRAW_MAX_BOXES )
+  {
+    fb = r->field_box + r->box_cnt;
+    fb->fds = ui->fds;
+    r->box_cnt++;
+  }
+  mui_redraw_draw_field(ui, fb, 1);
+  return 0;     /* continue with the loop */
+}
+
+/* 
+  draw dirty fields and all fields, which overlap with a cleared area
+  overlapping fields are completely inside the cleared area, see mui_redraw_grow_clear_boxes()
+  fields without visible output (like styles) are always executed, because they might change the graphics state 
+*/
+static uint8_t mui_task_redraw_dirty(mui_t *ui)
+{
+  mui_redraw_t *r = ui->redraw;
+  mui_field_box_t *fb = mui_redraw_find_field_box(r, ui->fds);
+  uint8_t i;
+  
+  for( i = 0; i < r->dirty_cnt; i++ )
+    if ( r->dirty_fds[i] == ui->fds )
+      break;
+  if ( i < r->dirty_cnt || fb == NULL || fb->box.x0 >= fb->box.x1 )
+  {
+    mui_redraw_draw_field(ui, fb, 1);   /* dirty or unknown field */
+    return 0;
+  }
+  for( i = 0; i < r->clear_cnt; i++ )
+    if ( mui_redraw_is_overlap(&(fb->box), r->clear_box+i) )
+    {
+      mui_redraw_draw_field(ui, fb, 0);  /* repaint the cleared field */
+      break;
+    }
+  return 0;     /* continue with the loop */
+}
+
+static uint8_t mui_redraw_send_cursor_msg(mui_t *ui, uint8_t msg)
+{
+  fds_t *form_fds = ui->current_form_fds;
+  fds_t *focus_fds = ui->cursor_focus_fds;
+  uint16_t scroll_top = ui->form_scroll_top;
+  uint16_t scroll_total = ui->form_scroll_total;
+  uint8_t scroll_visible = ui->form_scroll_visible;
+  uint8_t result;
+  
+  mui_redraw_mark_field(ui, focus_fds);
+  result = muif_get_cb(ui->uif)(ui, msg);
+  if ( form_fds != ui->current_form_fds || scroll_top != ui->form_scroll_top || 
+        scroll_total != ui->form_scroll_total || scroll_visible != ui->form_scroll_visible )
+    mui_redraw_mark_all(ui);    /* scrolling will move all fields of the form */
+  else if ( focus_fds != ui->cursor_focus_fds )
+    mui_redraw_mark_field(ui, ui->cursor_focus_fds);
+  return result;
+}
+
 /* === utility functions for the user API === */
 
 static uint8_t mui_send_cursor_msg(mui_t *ui, uint8_t msg) MUI_NOINLINE;
@@ -622,7 +1071,11 @@ static uint8_t mui_send_cursor_msg(mui_t *ui, uint8_t msg)
   {
     ui->fds = ui->cursor_focus_fds;
     if ( mui_prepare_current_field(ui) )
+    {
+      if ( ui->redraw != NULL )
+        return mui_redraw_send_cursor_msg(ui, msg);
       return muif_get_cb(ui->uif)(ui, msg);
+    }
   }
   return 0; /* not called, msg not handled */
 }
@@ -643,6 +1096,21 @@ uint8_t mui_GetCurrentCursorFocusPosition(mui_t *ui)
 {
   //fds_t *fds = ui->fds;
   ui->tmp8 = 0;  
+  if ( mui_index_prepare_fields(ui) )
+  {
+    mui_index_t *index = ui->index;
+    uint8_t i;
+    for( i = 0; i < index->field_cnt; i++ )
+    {
+      if ( mui_index_is_selectable(index->field+i) )
+      {
+        if ( index->field[i].fds == ui->cursor_focus_fds )
+          break;
+        ui->tmp8++;
+      }
+    }
+    return ui->tmp8;
+  }
   mui_loop_over_form(ui, mui_task_get_current_cursor_focus_position);
   //ui->fds = fds;
   return ui->tmp8;
@@ -656,6 +1124,12 @@ void mui_Draw(mui_t *ui)
 
 static void mui_next_field(mui_t *ui)
 {
+  if ( mui_index_prepare_fields(ui) )
+  {
+    mui_index_find_cursor_field(ui, 1);
+    ui->cursor_focus_fds = ui->target_fds;      // NULL is ok  
+    return;
+  }
   mui_loop_over_form(ui, mui_task_find_next_cursor_uif);
   // ui->cursor_focus_position++;
   ui->cursor_focus_fds = ui->target_fds;      // NULL is ok  
@@ -751,6 +1225,7 @@ void mui_EnterForm(mui_t *ui, fds_t *fds, uint8_t initial_cursor_position)
   
   /* assign the form, which should be entered */
   ui->current_form_fds = fds;
+  mui_redraw_mark_all(ui);
   
   /* inform all fields that we start a new form */
   MUI_DEBUG("mui_EnterForm: form_start, initial_cursor_position=%d\n", initial_cursor_position);
@@ -790,6 +1265,7 @@ void mui_LeaveForm(mui_t *ui)
   MUI_DEBUG("mui_LeaveForm: form_end\n");
   mui_loop_over_form(ui, mui_task_form_end);  
   ui->current_form_fds = NULL;
+  mui_redraw_mark_all(ui);
 }
 
 /* 0: error, form not found */
@@ -951,6 +1427,12 @@ void mui_PrevField(mui_t *ui)
       return;
     mui_send_cursor_msg(ui, MUIF_MSG_CURSOR_LEAVE);
  
+    if ( mui_index_prepare_fields(ui) )
+    {
+      mui_index_find_cursor_field(ui, 0);
+      ui->cursor_focus_fds = ui->target_fds;      // NULL is ok  
+      continue;
+    }
     mui_loop_over_form(ui, mui_task_find_prev_cursor_uif);
     ui->cursor_focus_fds = ui->target_fds;      // NULL is ok  
     if ( ui->target_fds == NULL )
@@ -1004,3 +1486,93 @@ void mui_SendValueDecrement(mui_t *ui)
 {
   mui_send_cursor_msg(ui, MUIF_MSG_VALUE_DECREMENT);  
 }
+
+
+/*
+  Enable partial redraw. "redraw" is provided by the caller and must exist as long as "ui" is used.
+  "cb" is the graphics specific clear and measure procedure, for u8g2 use mui_u8g2_redraw_cb.
+  Partial redraw requires that the display content is kept between two calls to mui_DrawDirty(),
+  for u8g2 this is the full buffer mode.
+*/
+void mui_SetRedraw(mui_t *ui, mui_redraw_t *redraw, mui_redraw_cb cb)
+{
+  ui->redraw = redraw;
+  if ( redraw != NULL )
+  {
+    memset(redraw, 0, sizeof(mui_redraw_t));
+    redraw->cb = cb;
+    redraw->is_all = 1;
+  }
+}
+
+void mui_MarkDirtyAll(mui_t *ui)
+{
+  mui_redraw_mark_all(ui);
+}
+
+/*
+  Redraw all fields, which have been changed since the last call to mui_DrawDirty().
+  The old area of each changed field is cleared, then the field and all other fields overlapping 
+  with the cleared area are drawn again (in the order of the form definition). The cleared area
+  is extended to the complete area of those overlapping fields.
+  The modified area is returned in ui->redraw->area and is empty if nothing has been changed.
+  Without mui_SetRedraw(), this is the same as mui_Draw().
+*/
+void mui_DrawDirty(mui_t *ui)
+{
+  mui_redraw_t *r = ui->redraw;
+  mui_field_box_t *fb;
+  uint8_t i;
+  
+  if ( r == NULL )
+  {
+    mui_Draw(ui);
+    return;
+  }
+  
+  r->area.x0 = 0;
+  r->area.y0 = 0;
+  r->area.x1 = 0;
+  r->area.y1 = 0;
+  r->clear_cnt = 0;
+  
+  /* all fields must have a known area, otherwise everything is drawn */
+  if ( r->box_cnt >= MUI_REDRAW_MAX_BOXES )
+    r->is_all = 1;
+  if ( r->is_all == 0 )
+  {
+    for( i = 0; i < r->dirty_cnt; i++ )
+    {
+      fb = mui_redraw_find_field_box(r, r->dirty_fds[i]);
+      if ( fb == NULL )
+      {
+        r->is_all = 1;
+        break;
+      }
+      r->clear_box[r->clear_cnt++] = fb->box;
+    }
+  }
+  
+  if ( r->is_all )
+  {
+    r->area.x1 = 0xffff;
+    r->area.y1 = 0xffff;
+    r->cb(ui, MUI_REDRAW_MSG_CLEAR, &(r->area));
+    r->box_cnt = 0;
+    mui_loop_over_form(ui, mui_task_redraw_all);
+  }
+  else if ( r->dirty_cnt > 0 )
+  {
+    mui_redraw_grow_clear_boxes(r);
+    for( i = 0; i < r->clear_cnt; i++ )
+    {
+      r->cb(ui, MUI_REDRAW_MSG_CLEAR, r->clear_box+i);
+      mui_redraw_extend_area(r, r->clear_box+i);
+    }
+    mui_loop_over_form(ui, mui_task_redraw_dirty);
+  }
+  
+  r->is_all = 0;
+  r->dirty_cnt = 0;
+  r->clear_cnt = 0;
+}
@@ -227,6 +227,91 @@ struct muif_struct
 
 #define MUI_MENU_LAST_FORM_STACK_SIZE 4
 
+/* 
+  optional index, see mui_InitWithIndex()
+  if there are more muif entries or more fields in a form, then the linear search is used 
+*/
+#ifndef MUI_INDEX_MAX_MUIF
+#define MUI_INDEX_MAX_MUIF 128
+#endif
+#ifndef MUI_INDEX_MAX_FIELDS
+#define MUI_INDEX_MAX_FIELDS 32
+#endif
+
+typedef struct mui_index_struct mui_index_t;
+typedef struct mui_index_field_struct mui_index_field_t;
+
+struct mui_index_field_struct
+{
+  fds_t *fds;           // start of the field command
+  muif_t *uif;          // NULL if there is no muif for this field
+  uint16_t len;         // complete size of the command, same as mui_fds_get_cmd_size()
+  uint8_t text_pos;     // position of the text delimiter, 0 if there is no text argument
+  uint8_t text_len;     // number of chars, which are copied to ui->text
+};
+
+struct mui_index_struct
+{
+  fds_t *form_fds[256];         // form id --> start of the form in the FDS, NULL if not defined
+  uint16_t muif_cnt;            // number of entries in muif_sorted, 0 if the linear search has to be used
+  uint16_t muif_sorted[MUI_INDEX_MAX_MUIF];     // muif positions, sorted by id0/id1, stable with respect to the muif list
+  
+  /* field cache of the current form */
+  fds_t *field_form_fds;        // the form of the field cache, NULL if the cache is invalid
+  uint8_t field_cnt;
+  uint8_t cursor_field_idx;     // cached position of ui->cursor_focus_fds within field[]
+  mui_index_field_t field[MUI_INDEX_MAX_FIELDS];
+};
+
+/*
+  optional partial redraw, see mui_SetRedraw() and mui_DrawDirty()
+  fields, which received a cursor or value message, are marked as dirty. mui_DrawDirty()
+  will clear and redraw only those fields and will report the modified area.
+  Boxes are in display (buffer) coordinates, x1 and y1 are exclusive.
+*/
+#ifndef MUI_REDRAW_MAX_DIRTY
+#define MUI_REDRAW_MAX_DIRTY 4
+#endif
+/* forms with MUI_REDRAW_MAX_BOXES or more fields are always drawn completely */
+#ifndef MUI_REDRAW_MAX_BOXES
+#define MUI_REDRAW_MAX_BOXES 32
+#endif
+
+/* messages for the mui_redraw_cb */
+#define MUI_REDRAW_MSG_CLEAR 0          /* clear the area of "box", clear everything if box->x1 is 0xffff */
+#define MUI_REDRAW_MSG_START 1          /* start measuring the area, which is drawn by the next field */
+#define MUI_REDRAW_MSG_END 2            /* stop measuring, store the measured area in "box" */
+
+typedef struct mui_box_struct mui_box_t;
+typedef struct mui_field_box_struct mui_field_box_t;
+typedef struct mui_redraw_struct mui_redraw_t;
+typedef void (*mui_redraw_cb)(mui_t *ui, uint8_t msg, mui_box_t *box);
+
+struct mui_box_struct
+{
+  uint16_t x0, y0;
+  uint16_t x1, y1;      // exclusive, the box is empty if x0 >= x1
+};
+
+struct mui_field_box_struct
+{
+  fds_t *fds;
+  mui_box_t box;        // area drawn by the field during the last redraw
+};
+
+struct mui_redraw_struct
+{
+  mui_redraw_cb cb;             // graphics specific clear and measure procedure, e.g. mui_u8g2_redraw_cb
+  uint8_t is_all;               // redraw the complete form with the next mui_DrawDirty()
+  uint8_t dirty_cnt;
+  uint8_t box_cnt;
+  uint8_t clear_cnt;            // temp. variable of mui_DrawDirty()
+  fds_t *dirty_fds[MUI_REDRAW_MAX_DIRTY];
+  mui_box_t clear_box[MUI_REDRAW_MAX_DIRTY];    // temp. variable of mui_DrawDirty()
+  mui_field_box_t field_box[MUI_REDRAW_MAX_BOXES];
+  mui_box_t area;               // result of mui_DrawDirty(): the modified area, empty if nothing has changed
+};
+
 struct mui_struct
 {
   void *graphics_data;
@@ -235,6 +320,9 @@ struct mui_struct
   muif_t *muif_tlist;
   size_t muif_tcnt;
   
+  mui_index_t *index;           // optional, assigned by mui_InitWithIndex()
+  mui_redraw_t *redraw;         // optional, assigned by mui_SetRedraw()
+  
   fds_t *current_form_fds;         // the current form, NULL if the ui is not active at the moment
   fds_t *cursor_focus_fds;           // the field which has the current cursor focus, NULL if there is no current focus
   fds_t *touch_focus_fds;            // the field which has touch focus
@@ -578,6 +666,7 @@ uint8_t mui_fds_get_nth_token(mui_t *ui, uint8_t n) MUI_NOINLINE;
 uint8_t mui_fds_get_token_cnt(mui_t *ui) MUI_NOINLINE;
 
 void mui_Init(mui_t *ui, void *graphics_data, fds_t *fds, muif_t *muif_tlist, size_t muif_tcnt);
+void mui_InitWithIndex(mui_t *ui, void *graphics_data, fds_t *fds, muif_t *muif_tlist, size_t muif_tcnt, mui_index_t *index);
 uint8_t mui_GetCurrentCursorFocusPosition(mui_t *ui) ;
 void mui_Draw(mui_t *ui);
 /* warning: The next function will overwrite the ui field variables like ui->arg, etc. 26 sep 2021: only ui->text is modified */
@@ -602,6 +691,10 @@ void mui_SendSelectWithExecuteOnSelectFieldSearch(mui_t *ui);  /* use this if MU
 void mui_SendValueIncrement(mui_t *ui);
 void mui_SendValueDecrement(mui_t *ui);
 
+void mui_SetRedraw(mui_t *ui, mui_redraw_t *redraw, mui_redraw_cb cb);
+void mui_MarkDirtyAll(mui_t *ui);       /* redraw all fields with the next mui_DrawDirty(), e.g. if a variable has been changed outside of mui */
+void mui_DrawDirty(mui_t *ui);
+
 
 
 #define mui_IsFormActive(ui) ((ui)->current_form_fds != NULL) 
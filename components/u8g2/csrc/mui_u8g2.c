@@ -400,6 +400,121 @@ uint8_t mui_u8g2_set_font_style_function(mui_t *ui, uint8_t msg)
 
 
 
+/*=========================================================================*/
+/* partial redraw */
+
+/*
+  Use with mui_SetRedraw(ui, &redraw, mui_u8g2_redraw_cb) and full buffer mode:
+    mui_DrawDirty(&ui);
+    mui_u8g2_UpdateDirtyArea(&ui);
+  The area of each field is measured by intercepting the low level hvline procedure,
+  so the boxes are in buffer coordinates.
+*/
+
+static u8g2_draw_ll_hvline_cb mui_u8g2_redraw_ll_hvline;
+static mui_box_t *mui_u8g2_redraw_box;
+
+static void mui_u8g2_redraw_measure_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  mui_box_t *b = mui_u8g2_redraw_box;
+  uint16_t x1 = x+1;
+  uint16_t y1 = y+1;
+  if ( dir == 0 )
+    x1 = x+len;
+  else
+    y1 = y+len;
+  if ( b->x0 >= b->x1 )
+  {
+    b->x0 = x;
+    b->y0 = y;
+    b->x1 = x1;
+    b->y1 = y1;
+  }
+  else
+  {
+    if ( b->x0 > x ) b->x0 = x;
+    if ( b->y0 > y ) b->y0 = y;
+    if ( b->x1 < x1 ) b->x1 = x1;
+    if ( b->y1 < y1 ) b->y1 = y1;
+  }
+  mui_u8g2_redraw_ll_hvline(u8g2, x, y, len, dir);
+}
+
+void mui_u8g2_redraw_cb(mui_t *ui, uint8_t msg, mui_box_t *box)
+{
+  u8g2_t *u8g2 = mui_get_U8g2(ui);
+  uint16_t x1, y1, y;
+  uint8_t draw_color;
+  
+  switch(msg)
+  {
+    case MUI_REDRAW_MSG_CLEAR:
+      if ( box->x1 == 0xffff )
+      {
+        u8g2_ClearBuffer(u8g2);
+        break;
+      }
+      x1 = box->x1;
+      y1 = box->y1;
+      if ( x1 > u8g2->pixel_buf_width )
+        x1 = u8g2->pixel_buf_width;
+      if ( y1 > u8g2->pixel_buf_height )
+        y1 = u8g2->pixel_buf_height;
+      if ( box->x0 >= x1 )
+        break;
+      draw_color = u8g2->draw_color;
+      u8g2->draw_color = 0;
+      for( y = box->y0; y < y1; y++ )
+        u8g2->ll_hvline(u8g2, box->x0, y, x1-box->x0, 0);
+      u8g2->draw_color = draw_color;
+      break;
+    case MUI_REDRAW_MSG_START:
+      box->x0 = 0;
+      box->y0 = 0;
+      box->x1 = 0;
+      box->y1 = 0;
+      mui_u8g2_redraw_box = box;
+      mui_u8g2_redraw_ll_hvline = u8g2->ll_hvline;
+      u8g2->ll_hvline = mui_u8g2_redraw_measure_hvline;
+      break;
+    case MUI_REDRAW_MSG_END:
+      u8g2->ll_hvline = mui_u8g2_redraw_ll_hvline;
+      break;
+  }
+}
+
+/*
+  Send the area, which was modified by the last mui_DrawDirty(), to the display.
+  Without mui_SetRedraw() the complete buffer is sent.
+*/
+void mui_u8g2_UpdateDirtyArea(mui_t *ui)
+{
+  u8g2_t *u8g2 = mui_get_U8g2(ui);
+  mui_redraw_t *r = ui->redraw;
+  uint16_t x1, y1;
+  uint8_t tx, ty;
+  
+  if ( r == NULL )
+  {
+    u8g2_SendBuffer(u8g2);
+    return;
+  }
+  
+  x1 = r->area.x1;
+  y1 = r->area.y1;
+  if ( x1 > u8g2->pixel_buf_width )
+    x1 = u8g2->pixel_buf_width;
+  if ( y1 > u8g2->pixel_buf_height )
+    y1 = u8g2->pixel_buf_height;
+  if ( r->area.x0 >= x1 || r->area.y0 >= y1 )
+    return;
+  
+  tx = r->area.x0 / 8;
+  ty = r->area.y0 / 8;
+  u8g2_UpdateDisplayArea(u8g2, tx, ty, (x1+7)/8 - tx, (y1+7)/8 - ty);
+}
+
+
 /*=========================================================================*/
 /* field functions */
 
@@ -199,6 +199,10 @@ void mui_u8g2_draw_button_pf(mui_t *ui, u8g2_uint_t width, u8g2_uint_t padding_h
 u8g2_uint_t mui_u8g2_get_if_flags(mui_t *ui);
 void mui_u8g2_draw_button_if(mui_t *ui, u8g2_uint_t width, u8g2_uint_t padding_h, const char *text);
 
+/* partial redraw, see mui_SetRedraw() */
+void mui_u8g2_redraw_cb(mui_t *ui, uint8_t msg, mui_box_t *box);
+void mui_u8g2_UpdateDirtyArea(mui_t *ui);
+
 
 
 /* ready to use field functions */
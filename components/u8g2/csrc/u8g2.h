@@ -83,9 +83,20 @@
   Defining this constant will disable all static memory allocation for device memory buffer and thus allows the user to allocate device buffers statically.
   Before using any display functions, the dynamic buffer *must* be assigned to the u8g2 struct using the u8g2_SetBufferPtr function.
   When using dynamic allocation, the stack size must be increased by u8g2_GetBufferSize bytes.
+  u8g2_SetBuffers() can be used instead of u8g2_SetBufferPtr() to assign one or more buffers,
+  for example from heap_caps_aligned_alloc(U8G2_BUFFER_ALIGNMENT, u8g2_GetBufferSize(&u8g2), MALLOC_CAP_DMA).
  */
 //#define U8G2_USE_DYNAMIC_ALLOC
 
+/*
+  Alignment of the display buffer in bytes (power of 2).
+  The static buffers in u8g2_d_memory.c are aligned to this value, buffers
+  assigned with u8g2_SetBuffers() must have the same alignment.
+*/
+#ifndef U8G2_BUFFER_ALIGNMENT
+#define U8G2_BUFFER_ALIGNMENT 4
+#endif
+
 /* U8g2 feature selection, see also https://github.com/olikraus/u8g2/wiki/u8g2optimization */
 
 /*
@@ -181,8 +192,10 @@
 
 #ifdef __GNUC__
 #  define U8G2_NOINLINE __attribute__((noinline))
+#  define U8G2_BUFFER_ALIGNED __attribute__((aligned(U8G2_BUFFER_ALIGNMENT)))
 #else
 #  define U8G2_NOINLINE
+#  define U8G2_BUFFER_ALIGNED
 #endif
 
 #define U8G2_FONT_SECTION(name) U8X8_FONT_SECTION(name) 
@@ -283,6 +296,7 @@ struct _u8g2_font_decode_t
   uint8_t is_transparent;
   uint8_t fg_color;
   uint8_t bg_color;
+  uint8_t scale;			/* scale factor for u8g2_DrawGlyphScaled() */
 #ifdef U8G2_WITH_FONT_ROTATION  
   uint8_t dir;				/* direction */
 #endif
@@ -297,9 +311,74 @@ struct _u8g2_kerning_t
   const uint16_t *index_to_second_table;
   const uint16_t *second_encoding_table;
   const uint8_t *kerning_values;
+  uint16_t flags;			/* U8G2_KERNING_SORTED, 0 for older tables */
 };
 typedef struct _u8g2_kerning_t u8g2_kerning_t;
 
+/* u8g2_kerning_t flags: first and second encoding tables are sorted, allows binary search */
+#define U8G2_KERNING_SORTED 0x0001
+
+/* 
+  first element of a sorted and indexed kerning table for u8g2_DrawExtUTF8 (created by bdfconv -k)
+    U8G2_KERNING_TABLE_INDEXED, n, 
+    e1[0], idx[0], ..., e1[n-1], idx[n-1], 0xffff, idx[n],	sorted by e1, idx[i]..idx[i+1]-1 are the pairs for e1[i]
+    e2, value, e2, value, ...					sorted by e2 for each e1
+    0xffff, 0xffff, 0xffff
+  tables without this marker are scanned linearly
+*/
+#define U8G2_KERNING_TABLE_INDEXED 0x0fffe
+
+/* 
+  string run: the glyphs of a string, resolved once by u8g2_LayoutStr() or u8g2_LayoutUTF8()
+  and then used for measure and draw without another glyph lookup
+*/
+struct _u8g2_str_glyph_t
+{
+  const uint8_t *glyph_data;	/* NULL if the glyph does not exist in the font */
+  int8_t dx;				/* delta x advance */
+};
+typedef struct _u8g2_str_glyph_t u8g2_str_glyph_t;
+
+struct _u8g2_str_run_t
+{
+  const uint8_t *font;		/* the run is valid for this font only */
+  const char *str;			/* the string of the run, used if the glyph array is too small */
+  u8g2_str_glyph_t *glyph;	/* caller supplied array with "max" entries */
+  uint8_t max;
+  uint8_t cnt;			/* number of glyphs, larger than "max" if the array was too small */
+  uint8_t is_utf8;
+  int8_t x_offset;			/* x offset of the first glyph */
+  int8_t ascent;			/* max height above the baseline of all glyphs */
+  int8_t descent;			/* min extent below the baseline of all glyphs (negative) */
+  u8g2_uint_t width;		/* same result as u8g2_GetStrWidth() or u8g2_GetUTF8Width() */
+};
+typedef struct _u8g2_str_run_t u8g2_str_run_t;
+
+/* string width cache, see u8g2_GetStrWidthCached() */
+#ifndef U8G2_STR_WIDTH_CACHE_CNT
+#define U8G2_STR_WIDTH_CACHE_CNT 8
+#endif
+/* longer strings are not cached */
+#ifndef U8G2_STR_WIDTH_CACHE_LEN
+#define U8G2_STR_WIDTH_CACHE_LEN 15
+#endif
+
+struct _u8g2_str_width_entry_t
+{
+  const uint8_t *font;		/* NULL: unused entry */
+  u8g2_uint_t width;
+  uint8_t is_utf8;
+  char str[U8G2_STR_WIDTH_CACHE_LEN+1];
+};
+typedef struct _u8g2_str_width_entry_t u8g2_str_width_entry_t;
+
+struct _u8g2_str_width_cache_t
+{
+  u8g2_str_width_entry_t entry[U8G2_STR_WIDTH_CACHE_CNT];
+  uint8_t next;			/* next entry, which will be replaced */
+};
+typedef struct _u8g2_str_width_cache_t u8g2_str_width_cache_t;
+
 
 struct u8g2_cb_struct
 {
@@ -321,6 +400,9 @@ struct u8g2_struct
   uint8_t *tile_buf_ptr;	/* ptr to memory area with u8x8.display_info->tile_width * 8 * tile_buf_height bytes */
   uint8_t tile_buf_height;	/* height of the tile memory area in tile rows */
   uint8_t tile_curr_row;	/* current row for picture loop */
+  uint8_t **buf_list;		/* buffers assigned with u8g2_SetBuffers(), NULL if not used */
+  uint8_t buf_cnt;		/* number of buffers in buf_list */
+  uint8_t buf_idx;		/* index of tile_buf_ptr in buf_list */
   
   /* dimension of the buffer in pixel */
   u8g2_uint_t pixel_buf_width;		/* equal to tile_buf_width*8 */
@@ -1771,12 +1853,30 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 #endif
 
 #ifdef U8G2_USE_DYNAMIC_ALLOC
-#define u8g2_SetBufferPtr(u8g2, buf) ((u8g2)->tile_buf_ptr = (buf));
+/* assign one buffer, a buffer list of u8g2_SetBuffers() is removed */
+#define u8g2_SetBufferPtr(u8g2, buf) ((u8g2)->tile_buf_ptr = (buf), (u8g2)->buf_list = NULL, (u8g2)->buf_cnt = 0, (u8g2)->buf_idx = 0);
 #endif
 #define u8g2_GetBufferSize(u8g2) ((u8g2)->u8x8.display_info->tile_width * 8 * (u8g2)->tile_buf_height)
 #define u8g2_GetBufferPtr(u8g2) ((u8g2)->tile_buf_ptr)
 #define u8g2_GetBufferTileHeight(u8g2)	((u8g2)->tile_buf_height)
 #define u8g2_GetBufferTileWidth(u8g2)	(u8g2_GetU8x8(u8g2)->display_info->tile_width)
+#define u8g2_GetBufferAlignment(u8g2) (U8G2_BUFFER_ALIGNMENT)
+
+/* assign cnt buffers with u8g2_GetBufferSize() bytes, returns 0 if a buffer is NULL or not aligned */
+uint8_t u8g2_SetBuffers(u8g2_t *u8g2, uint8_t **buf_list, uint8_t cnt);
+/* rotate to the next buffer of u8g2_SetBuffers(), returns the new current buffer */
+uint8_t *u8g2_NextBuffer(u8g2_t *u8g2);
+
+/* buffer level fill procedures, no rotation, no clip window, pattern: 8 bytes, MSB is the left pixel */
+extern const uint8_t u8g2_pattern_checkerboard[8];
+extern const uint8_t u8g2_pattern_hstripes[8];
+extern const uint8_t u8g2_pattern_vstripes[8];
+void u8g2_GetDitherPattern(uint8_t level, uint8_t *pattern);
+void u8g2_FillBuffer(u8g2_t *u8g2, const uint8_t *pattern);
+void u8g2_FillBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *pattern);
+void u8g2_ClearBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_InvertBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_DitherBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t level);
 /* the following variable is only valid after calling u8g2_FirstPage */
 /* renamed from Page to Buffer: the CurrTileRow is the current row of the buffer, issue #370 */
 #define u8g2_GetPageCurrTileRow(u8g2) ((u8g2)->tile_curr_row)
@@ -1791,6 +1891,25 @@ void u8g2_WriteBufferXBM(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferPBM2(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM2(u8g2_t *u8g2, void (*out)(const char *s));
 
+/*==========================================*/
+/* u8g2_epd.c */
+
+/* refresh manager for e-paper displays with partial refresh, full buffer mode only */
+typedef struct u8g2_epd_struct u8g2_epd_t;
+struct u8g2_epd_struct
+{
+  uint8_t *shadow;			/* last frame, u8g2_GetBufferSize() bytes, provided by the user */
+  uint16_t changed_tiles;		/* number of changed tiles since the last full refresh */
+  uint16_t max_changed_tiles;	/* ghosting threshold for changed_tiles, 0: no limit */
+  uint8_t partial_cnt;		/* number of partial refreshes since the last full refresh */
+  uint8_t max_partial;		/* full refresh after this number of partial refreshes, 0: no limit */
+  uint8_t is_full_refresh_required;
+};
+
+void u8g2_epd_Init(u8g2_epd_t *epd, uint8_t *shadow, uint8_t max_partial, uint16_t max_changed_tiles);
+uint8_t u8g2_epd_SendBuffer(u8g2_t *u8g2, u8g2_epd_t *epd);	/* 0: no change, 1: partial refresh, 2: full refresh */
+#define u8g2_epd_ForceFullRefresh(epd) ((epd)->is_full_refresh_required = 1)
+
 
 /*==========================================*/
 /* u8g2_ll_hvline.c */
@@ -1937,6 +2056,7 @@ int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding);
 
 u8g2_uint_t u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
 u8g2_uint_t u8g2_DrawGlyphX2(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
+u8g2_uint_t u8g2_DrawGlyphScaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, uint16_t encoding);
 int8_t u8g2_GetStrX(u8g2_t *u8g2, const char *s);	/* for u8g compatibility, WARNING: use u8g2_GetGlyphXOffset() instead! */
 int8_t u8g2_GetXOffsetGlyph(u8g2_t *u8g2, uint16_t encoding);
 int8_t u8g2_GetXOffsetUTF8(u8g2_t *u8g2, const char *utf8);
@@ -1946,6 +2066,8 @@ u8g2_uint_t u8g2_DrawStr(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char
 u8g2_uint_t u8g2_DrawStrX2(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str);
 u8g2_uint_t u8g2_DrawUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str);
 u8g2_uint_t u8g2_DrawUTF8X2(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str);
+u8g2_uint_t u8g2_DrawStrScaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *str);
+u8g2_uint_t u8g2_DrawUTF8Scaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *str);
 u8g2_uint_t u8g2_DrawExtendedUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t to_left, u8g2_kerning_t *kerning, const char *str);
 u8g2_uint_t u8g2_DrawExtUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t to_left, const uint16_t *kerning_table, const char *str);
 
@@ -1960,6 +2082,20 @@ uint8_t u8g2_IsAllValidUTF8(u8g2_t *u8g2, const char *str);	// checks whether al
 
 u8g2_uint_t u8g2_GetStrWidth(u8g2_t *u8g2, const char *s);
 u8g2_uint_t u8g2_GetUTF8Width(u8g2_t *u8g2, const char *str);
+
+#define U8G2_ALIGN_LEFT 0
+#define U8G2_ALIGN_CENTER 1
+#define U8G2_ALIGN_RIGHT 2
+
+uint8_t u8g2_LayoutStr(u8g2_t *u8g2, u8g2_str_run_t *run, u8g2_str_glyph_t *glyph, uint8_t max, const char *str);
+uint8_t u8g2_LayoutUTF8(u8g2_t *u8g2, u8g2_str_run_t *run, u8g2_str_glyph_t *glyph, uint8_t max, const char *str);
+u8g2_uint_t u8g2_DrawStrRun(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const u8g2_str_run_t *run);
+u8g2_uint_t u8g2_DrawStrRunAligned(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, uint8_t align, const u8g2_str_run_t *run);
+#define u8g2_GetStrRunWidth(run) ((run)->width)
+
+void u8g2_ClearStrWidthCache(u8g2_str_width_cache_t *cache);
+u8g2_uint_t u8g2_GetStrWidthCached(u8g2_t *u8g2, u8g2_str_width_cache_t *cache, const char *s);
+u8g2_uint_t u8g2_GetUTF8WidthCached(u8g2_t *u8g2, u8g2_str_width_cache_t *cache, const char *s);
 /*u8g2_uint_t u8g2_GetExactStrWidth(u8g2_t *u8g2, const char *s);*/ /*obsolete, see also https://github.com/olikraus/u8g2/issues/1561 */
 
 
@@ -40,12 +40,331 @@
 void u8g2_ClearBuffer(u8g2_t *u8g2)
 {
   size_t cnt;
+  U8X8_TIMING_START_RENDER(u8g2_GetU8x8(u8g2));
   cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
   memset(u8g2->tile_buf_ptr, 0, cnt);
 }
 
+/*============================================*/
+/*
+  Assign one or more buffers, each with u8g2_GetBufferSize() bytes and
+  aligned to U8G2_BUFFER_ALIGNMENT. The first buffer becomes the current buffer.
+  This must be called after the u8g2_Setup_...() procedure. buf_list itself
+  is not copied and must stay valid.
+  With two or more buffers, u8g2_NextBuffer() rotates through the list: The next
+  buffer becomes the current buffer and the content of the other buffers is kept,
+  for example to compare the new frame with the last one. This is not double
+  buffering, u8g2_SendBuffer() returns after the transfer has been completed.
+  u8g2_SetBufferPtr() removes the buffer list.
+  Returns 0 if a buffer is NULL or not aligned, the buffers are not changed then.
+*/
+uint8_t u8g2_SetBuffers(u8g2_t *u8g2, uint8_t **buf_list, uint8_t cnt)
+{
+  uint8_t i;
+  if ( cnt == 0 )
+    return 0;
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( buf_list[i] == NULL )
+      return 0;
+    if ( ((uintptr_t)buf_list[i] & (U8G2_BUFFER_ALIGNMENT-1)) != 0 )
+      return 0;
+  }
+  u8g2->buf_list = buf_list;
+  u8g2->buf_cnt = cnt;
+  u8g2->buf_idx = 0;
+  u8g2->tile_buf_ptr = buf_list[0];
+  return 1;
+}
+
+uint8_t *u8g2_NextBuffer(u8g2_t *u8g2)
+{
+  if ( u8g2->buf_cnt > 1 )
+  {
+    u8g2->buf_idx++;
+    if ( u8g2->buf_idx >= u8g2->buf_cnt )
+      u8g2->buf_idx = 0;
+    u8g2->tile_buf_ptr = u8g2->buf_list[u8g2->buf_idx];
+  }
+  return u8g2->tile_buf_ptr;
+}
+
+/*============================================*/
+/*
+  Pattern fill, box clear/invert and ordered dither directly in the buffer.
+
+  x, y, w, h are display pixel coordinates without rotation (like u8g2_R0).
+  The clip window and the draw color are ignored. In page mode, only the
+  part inside the current page is modified.
+
+  pattern: 8 bytes, one byte for each pixel row, the MSB is the left pixel
+  (same as u8g2_DrawBitmap). The pattern is repeated every 8 pixel and
+  aligned to the upper left corner of the display.
+
+  The inner part of each tile row (vertical layout) or pixel row
+  (horizontal layout) is processed with 32 bit words, if the buffer is
+  aligned (see U8G2_BUFFER_ALIGNMENT).
+*/
+
+#ifdef __GNUC__
+typedef uint32_t __attribute__((may_alias)) u8g2_buf_word_t;
+#else
+typedef uint32_t u8g2_buf_word_t;
+#endif
+
+const uint8_t u8g2_pattern_checkerboard[8] = { 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55 };
+const uint8_t u8g2_pattern_hstripes[8] = { 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00 };
+const uint8_t u8g2_pattern_vstripes[8] = { 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa };
+
+static const uint8_t u8g2_pattern_zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+static const uint8_t u8g2_pattern_one[8] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+/* 8x8 Bayer matrix for the ordered dither */
+static const uint8_t u8g2_bayer8[64] =
+{
+   0, 32,  8, 40,  2, 34, 10, 42,
+  48, 16, 56, 24, 50, 18, 58, 26,
+  12, 44,  4, 36, 14, 46,  6, 38,
+  60, 28, 52, 20, 62, 30, 54, 22,
+   3, 35, 11, 43,  1, 33,  9, 41,
+  51, 19, 59, 27, 49, 17, 57, 25,
+  15, 47,  7, 39, 13, 45,  5, 37,
+  63, 31, 55, 23, 61, 29, 53, 21
+};
+
+/*
+  level: 0 (no pixel) ... 64 (all pixel)
+  pattern: 8 bytes, receives the ordered dither pattern for this level
+*/
+void u8g2_GetDitherPattern(uint8_t level, uint8_t *pattern)
+{
+  uint8_t x, y, b;
+  const uint8_t *m = u8g2_bayer8;
+  for( y = 0; y < 8; y++ )
+  {
+    b = 0;
+    for( x = 0; x < 8; x++ )
+    {
+      b <<= 1;
+      if ( *m++ < level )
+        b |= 1;
+    }
+    pattern[y] = b;
+  }
+}
+
+/*
+  modify len bytes, starting at ptr
+  pat: 16 bytes, two periods of the pattern, phase: pattern index of the first byte
+  mask: bits which are modified in each byte
+  is_xor: 0: copy the pattern into the masked bits, 1: invert the masked bits, where the pattern is set
+*/
+static void u8g2_buffer_span(uint8_t *ptr, uint16_t len, const uint8_t *pat, uint8_t phase, uint8_t mask, uint8_t is_xor)
+{
+  u8g2_buf_word_t *wptr;
+  uint32_t w0, w1, wm;
+
+  /* unaligned start */
+  while( len > 0 && ((uintptr_t)ptr & 3) != 0 )
+  {
+    if ( is_xor )
+      *ptr ^= pat[phase] & mask;
+    else
+      *ptr = (*ptr & ~mask) | (pat[phase] & mask);
+    ptr++;
+    phase = (phase+1) & 7;
+    len--;
+  }
+
+  /* aligned words, the pattern repeats every two words */
+  if ( len >= 4 )
+  {
+    memcpy(&w0, pat + phase, 4);
+    memcpy(&w1, pat + ((phase+4) & 7), 4);
+    wm = mask * 0x01010101UL;
+    w0 &= wm;
+    w1 &= wm;
+    wptr = (u8g2_buf_word_t *)ptr;
+    if ( is_xor )
+    {
+      while( len >= 8 )
+      {
+	wptr[0] ^= w0;
+	wptr[1] ^= w1;
+	wptr += 2;
+	len -= 8;
+      }
+      if ( len >= 4 )
+      {
+	*wptr++ ^= w0;
+	len -= 4;
+	phase = (phase+4) & 7;
+      }
+    }
+    else
+    {
+      wm = ~wm;
+      while( len >= 8 )
+      {
+	wptr[0] = (wptr[0] & wm) | w0;
+	wptr[1] = (wptr[1] & wm) | w1;
+	wptr += 2;
+	len -= 8;
+      }
+      if ( len >= 4 )
+      {
+	*wptr = (*wptr & wm) | w0;
+	wptr++;
+	len -= 4;
+	phase = (phase+4) & 7;
+      }
+    }
+    ptr = (uint8_t *)wptr;
+  }
+
+  /* remaining bytes */
+  while( len > 0 )
+  {
+    if ( is_xor )
+      *ptr ^= pat[phase] & mask;
+    else
+      *ptr = (*ptr & ~mask) | (pat[phase] & mask);
+    ptr++;
+    phase = (phase+1) & 7;
+    len--;
+  }
+}
+
+/* SSD13xx, UC17xx, UC16xx: one byte for 8 vertical pixel, LSB at the top */
+static void u8g2_buffer_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *pattern, uint8_t is_xor)
+{
+  uint8_t pat[16];
+  uint8_t c, r, b, n, mask;
+  uint8_t *ptr;
+
+  /* transpose the pattern: one byte for each pixel column */
+  for( c = 0; c < 8; c++ )
+  {
+    b = 0;
+    for( r = 0; r < 8; r++ )
+      if ( pattern[r] & (128 >> c) )
+	b |= 1 << r;
+    pat[c] = b;
+    pat[c+8] = b;
+  }
+
+  ptr = u8g2->tile_buf_ptr;
+  ptr += (uint16_t)(y >> 3) * u8g2->pixel_buf_width;
+  ptr += x;
+  while( h > 0 )
+  {
+    r = y & 7;
+    n = 8 - r;
+    if ( n > h )
+      n = h;
+    mask = (0x0ff >> (8-n)) << r;
+    u8g2_buffer_span(ptr, w, pat, x & 7, mask, is_xor);
+    ptr += u8g2->pixel_buf_width;
+    y += n;
+    h -= n;
+  }
+}
+
+/* ST7920 and others: one byte for 8 horizontal pixel, MSB at the left */
+static void u8g2_buffer_box_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *pattern, uint8_t is_xor)
+{
+  uint8_t pat[16];
+  uint8_t *ptr;
+  uint8_t left_mask, right_mask;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  u8g2_uint_t x1 = x + w - 1;	/* last pixel */
+  uint16_t cnt = (x1 >> 3) - (x >> 3);	/* number of bytes after the first byte */
+
+  left_mask = 0x0ff >> (x & 7);
+  right_mask = 0x0ff << (7 - (x1 & 7));
+  if ( cnt == 0 )
+    left_mask &= right_mask;
+
+  ptr = u8g2->tile_buf_ptr;
+  ptr += (uint16_t)y * tile_width;
+  ptr += x >> 3;
+  while( h > 0 )
+  {
+    memset(pat, pattern[y & 7], 16);
+    u8g2_buffer_span(ptr, 1, pat, 0, left_mask, is_xor);
+    if ( cnt > 0 )
+    {
+      u8g2_buffer_span(ptr+1, cnt-1, pat, 0, 0x0ff, is_xor);
+      u8g2_buffer_span(ptr+cnt, 1, pat, 0, right_mask, is_xor);
+    }
+    ptr += tile_width;
+    y++;
+    h--;
+  }
+}
+
+static void u8g2_buffer_box(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *pattern, uint8_t is_xor)
+{
+  /* clip against the current page, y is converted to the local buffer position */
+  if ( y < u8g2->pixel_curr_row )
+  {
+    if ( h <= u8g2->pixel_curr_row - y )
+      return;
+    h -= u8g2->pixel_curr_row - y;
+    y = u8g2->pixel_curr_row;
+  }
+  y -= u8g2->pixel_curr_row;
+  if ( y >= u8g2->pixel_buf_height )
+    return;
+  if ( h > u8g2->pixel_buf_height - y )
+    h = u8g2->pixel_buf_height - y;
+  if ( x >= u8g2->pixel_buf_width )
+    return;
+  if ( w > u8g2->pixel_buf_width - x )
+    w = u8g2->pixel_buf_width - x;
+  if ( w == 0 || h == 0 )
+    return;
+
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    u8g2_buffer_box_horizontal_right_lsb(u8g2, x, y, w, h, pattern, is_xor);
+  else
+    u8g2_buffer_box_vertical_top_lsb(u8g2, x, y, w, h, pattern, is_xor);
+}
+
+/* replace the box with the pattern */
+void u8g2_FillBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *pattern)
+{
+  u8g2_buffer_box(u8g2, x, y, w, h, pattern, 0);
+}
+
+/* same as u8g2_DrawBox() with draw color 0 */
+void u8g2_ClearBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_buffer_box(u8g2, x, y, w, h, u8g2_pattern_zero, 0);
+}
+
+/* same as u8g2_DrawBox() with draw color 2 (XOR) */
+void u8g2_InvertBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_buffer_box(u8g2, x, y, w, h, u8g2_pattern_one, 1);
+}
+
+/* replace the box with an ordered dither pattern, level: 0 (no pixel set) ... 64 (all pixel set) */
+void u8g2_DitherBufferBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t level)
+{
+  uint8_t pattern[8];
+  u8g2_GetDitherPattern(level, pattern);
+  u8g2_buffer_box(u8g2, x, y, w, h, pattern, 0);
+}
+
+/* replace the complete buffer (current page) with the pattern */
+void u8g2_FillBuffer(u8g2_t *u8g2, const uint8_t *pattern)
+{
+  u8g2_buffer_box(u8g2, 0, u8g2->pixel_curr_row, u8g2->pixel_buf_width, u8g2->pixel_buf_height, pattern, 0);
+}
+
 /*============================================*/
 
 static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
@@ -92,8 +411,11 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
 void u8g2_SendBuffer(u8g2_t *u8g2)
 {
+  U8X8_TIMING_END_RENDER(u8g2_GetU8x8(u8g2));
+  U8X8_TIMING_BEGIN(u8g2_GetU8x8(u8g2));
   u8g2_send_buffer(u8g2);
   u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );  
+  U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_SEND, u8g2_GetBufferSize(u8g2));
 }
 
 /*============================================*/
@@ -106,6 +428,7 @@ void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row)
 
 void u8g2_FirstPage(u8g2_t *u8g2)
 {
+  U8X8_TIMING_START_RENDER(u8g2_GetU8x8(u8g2));
   if ( u8g2->is_auto_page_clear )
   {
     u8g2_ClearBuffer(u8g2);
@@ -116,14 +439,19 @@ void u8g2_FirstPage(u8g2_t *u8g2)
 uint8_t u8g2_NextPage(u8g2_t *u8g2)
 {
   uint8_t row;
+  U8X8_TIMING_END_RENDER(u8g2_GetU8x8(u8g2));
+  U8X8_TIMING_BEGIN(u8g2_GetU8x8(u8g2));
   u8g2_send_buffer(u8g2);
   row = u8g2->tile_curr_row;
   row += u8g2->tile_buf_height;
   if ( row >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
   {
     u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+    U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_SEND, u8g2_GetBufferSize(u8g2));
     return 0;
   }
+  U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_SEND, u8g2_GetBufferSize(u8g2));
+  U8X8_TIMING_START_RENDER(u8g2_GetU8x8(u8g2));
   if ( u8g2->is_auto_page_clear )
   {
     u8g2_ClearBuffer(u8g2);
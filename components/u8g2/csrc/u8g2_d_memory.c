@@ -9,7 +9,7 @@ uint8_t *u8g2_m_16_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -20,7 +20,7 @@ uint8_t *u8g2_m_16_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -31,7 +31,7 @@ uint8_t *u8g2_m_16_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -42,7 +42,7 @@ uint8_t *u8g2_m_16_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -53,7 +53,7 @@ uint8_t *u8g2_m_16_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -64,7 +64,7 @@ uint8_t *u8g2_m_16_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[1024];
+  static uint8_t buf[1024] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -75,7 +75,7 @@ uint8_t *u8g2_m_255_2_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[2040];
+  static uint8_t buf[2040] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -86,7 +86,7 @@ uint8_t *u8g2_m_255_2_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[4080];
+  static uint8_t buf[4080] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -97,7 +97,7 @@ uint8_t *u8g2_m_255_2_f(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[4080];
+  static uint8_t buf[4080] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -108,7 +108,7 @@ uint8_t *u8g2_m_9_5_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[72];
+  static uint8_t buf[72] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -119,7 +119,7 @@ uint8_t *u8g2_m_9_5_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[144];
+  static uint8_t buf[144] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -130,7 +130,7 @@ uint8_t *u8g2_m_9_5_f(uint8_t *page_cnt)
   *page_cnt = 5;
   return 0;
   #else
-  static uint8_t buf[360];
+  static uint8_t buf[360] U8G2_BUFFER_ALIGNED;
   *page_cnt = 5;
   return buf;
   #endif
@@ -141,7 +141,7 @@ uint8_t *u8g2_m_12_5_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -152,7 +152,7 @@ uint8_t *u8g2_m_12_5_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -163,7 +163,7 @@ uint8_t *u8g2_m_12_5_f(uint8_t *page_cnt)
   *page_cnt = 5;
   return 0;
   #else
-  static uint8_t buf[480];
+  static uint8_t buf[480] U8G2_BUFFER_ALIGNED;
   *page_cnt = 5;
   return buf;
   #endif
@@ -174,7 +174,7 @@ uint8_t *u8g2_m_8_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[64];
+  static uint8_t buf[64] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -185,7 +185,7 @@ uint8_t *u8g2_m_8_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -196,7 +196,7 @@ uint8_t *u8g2_m_8_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -207,7 +207,7 @@ uint8_t *u8g2_m_8_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[64];
+  static uint8_t buf[64] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -218,7 +218,7 @@ uint8_t *u8g2_m_8_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -229,7 +229,7 @@ uint8_t *u8g2_m_8_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[1024];
+  static uint8_t buf[1024] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -240,7 +240,7 @@ uint8_t *u8g2_m_12_12_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -251,7 +251,7 @@ uint8_t *u8g2_m_12_12_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -262,7 +262,7 @@ uint8_t *u8g2_m_12_12_f(uint8_t *page_cnt)
   *page_cnt = 12;
   return 0;
   #else
-  static uint8_t buf[1152];
+  static uint8_t buf[1152] U8G2_BUFFER_ALIGNED;
   *page_cnt = 12;
   return buf;
   #endif
@@ -273,7 +273,7 @@ uint8_t *u8g2_m_10_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[80];
+  static uint8_t buf[80] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -284,7 +284,7 @@ uint8_t *u8g2_m_10_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -295,7 +295,7 @@ uint8_t *u8g2_m_10_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[1280];
+  static uint8_t buf[1280] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -306,7 +306,7 @@ uint8_t *u8g2_m_16_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -317,7 +317,7 @@ uint8_t *u8g2_m_16_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -328,7 +328,7 @@ uint8_t *u8g2_m_16_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[2048];
+  static uint8_t buf[2048] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -339,7 +339,7 @@ uint8_t *u8g2_m_16_20_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -350,7 +350,7 @@ uint8_t *u8g2_m_16_20_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -361,7 +361,7 @@ uint8_t *u8g2_m_16_20_f(uint8_t *page_cnt)
   *page_cnt = 20;
   return 0;
   #else
-  static uint8_t buf[2560];
+  static uint8_t buf[2560] U8G2_BUFFER_ALIGNED;
   *page_cnt = 20;
   return buf;
   #endif
@@ -372,7 +372,7 @@ uint8_t *u8g2_m_20_20_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -383,7 +383,7 @@ uint8_t *u8g2_m_20_20_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -394,7 +394,7 @@ uint8_t *u8g2_m_20_20_f(uint8_t *page_cnt)
   *page_cnt = 20;
   return 0;
   #else
-  static uint8_t buf[3200];
+  static uint8_t buf[3200] U8G2_BUFFER_ALIGNED;
   *page_cnt = 20;
   return buf;
   #endif
@@ -405,7 +405,7 @@ uint8_t *u8g2_m_32_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -416,7 +416,7 @@ uint8_t *u8g2_m_32_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -427,7 +427,7 @@ uint8_t *u8g2_m_32_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[2048];
+  static uint8_t buf[2048] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -438,7 +438,7 @@ uint8_t *u8g2_m_13_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[104];
+  static uint8_t buf[104] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -449,7 +449,7 @@ uint8_t *u8g2_m_13_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[208];
+  static uint8_t buf[208] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -460,7 +460,7 @@ uint8_t *u8g2_m_13_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[832];
+  static uint8_t buf[832] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -471,7 +471,7 @@ uint8_t *u8g2_m_8_6_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[64];
+  static uint8_t buf[64] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -482,7 +482,7 @@ uint8_t *u8g2_m_8_6_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -493,7 +493,7 @@ uint8_t *u8g2_m_8_6_f(uint8_t *page_cnt)
   *page_cnt = 6;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 6;
   return buf;
   #endif
@@ -504,7 +504,7 @@ uint8_t *u8g2_m_6_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[48];
+  static uint8_t buf[48] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -515,7 +515,7 @@ uint8_t *u8g2_m_6_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -526,7 +526,7 @@ uint8_t *u8g2_m_6_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -537,7 +537,7 @@ uint8_t *u8g2_m_12_2_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -548,7 +548,7 @@ uint8_t *u8g2_m_12_2_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -559,7 +559,7 @@ uint8_t *u8g2_m_12_2_f(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -570,7 +570,7 @@ uint8_t *u8g2_m_15_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[120];
+  static uint8_t buf[120] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -581,7 +581,7 @@ uint8_t *u8g2_m_15_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[240];
+  static uint8_t buf[240] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -592,7 +592,7 @@ uint8_t *u8g2_m_15_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[480];
+  static uint8_t buf[480] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -603,7 +603,7 @@ uint8_t *u8g2_m_12_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -614,7 +614,7 @@ uint8_t *u8g2_m_12_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -625,7 +625,7 @@ uint8_t *u8g2_m_12_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -636,7 +636,7 @@ uint8_t *u8g2_m_16_12_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -647,7 +647,7 @@ uint8_t *u8g2_m_16_12_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -658,7 +658,7 @@ uint8_t *u8g2_m_16_12_f(uint8_t *page_cnt)
   *page_cnt = 12;
   return 0;
   #else
-  static uint8_t buf[1536];
+  static uint8_t buf[1536] U8G2_BUFFER_ALIGNED;
   *page_cnt = 12;
   return buf;
   #endif
@@ -669,7 +669,7 @@ uint8_t *u8g2_m_32_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -680,7 +680,7 @@ uint8_t *u8g2_m_32_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -691,7 +691,7 @@ uint8_t *u8g2_m_32_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[1024];
+  static uint8_t buf[1024] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -702,7 +702,7 @@ uint8_t *u8g2_m_12_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -713,7 +713,7 @@ uint8_t *u8g2_m_12_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -724,7 +724,7 @@ uint8_t *u8g2_m_12_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[768];
+  static uint8_t buf[768] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -735,7 +735,7 @@ uint8_t *u8g2_m_16_5_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -746,7 +746,7 @@ uint8_t *u8g2_m_16_5_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -757,7 +757,7 @@ uint8_t *u8g2_m_16_5_f(uint8_t *page_cnt)
   *page_cnt = 5;
   return 0;
   #else
-  static uint8_t buf[640];
+  static uint8_t buf[640] U8G2_BUFFER_ALIGNED;
   *page_cnt = 5;
   return buf;
   #endif
@@ -768,7 +768,7 @@ uint8_t *u8g2_m_18_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[144];
+  static uint8_t buf[144] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -779,7 +779,7 @@ uint8_t *u8g2_m_18_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[288];
+  static uint8_t buf[288] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -790,7 +790,7 @@ uint8_t *u8g2_m_18_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[576];
+  static uint8_t buf[576] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -801,7 +801,7 @@ uint8_t *u8g2_m_20_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -812,7 +812,7 @@ uint8_t *u8g2_m_20_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -823,7 +823,7 @@ uint8_t *u8g2_m_20_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[640];
+  static uint8_t buf[640] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -834,7 +834,7 @@ uint8_t *u8g2_m_24_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -845,7 +845,7 @@ uint8_t *u8g2_m_24_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -856,7 +856,7 @@ uint8_t *u8g2_m_24_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[768];
+  static uint8_t buf[768] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -867,7 +867,7 @@ uint8_t *u8g2_m_50_30_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[400];
+  static uint8_t buf[400] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -878,7 +878,7 @@ uint8_t *u8g2_m_50_30_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[800];
+  static uint8_t buf[800] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -889,7 +889,7 @@ uint8_t *u8g2_m_50_30_f(uint8_t *page_cnt)
   *page_cnt = 30;
   return 0;
   #else
-  static uint8_t buf[12000];
+  static uint8_t buf[12000] U8G2_BUFFER_ALIGNED;
   *page_cnt = 30;
   return buf;
   #endif
@@ -900,7 +900,7 @@ uint8_t *u8g2_m_18_21_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[144];
+  static uint8_t buf[144] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -911,7 +911,7 @@ uint8_t *u8g2_m_18_21_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[288];
+  static uint8_t buf[288] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -922,7 +922,7 @@ uint8_t *u8g2_m_18_21_f(uint8_t *page_cnt)
   *page_cnt = 21;
   return 0;
   #else
-  static uint8_t buf[3024];
+  static uint8_t buf[3024] U8G2_BUFFER_ALIGNED;
   *page_cnt = 21;
   return buf;
   #endif
@@ -933,7 +933,7 @@ uint8_t *u8g2_m_20_9_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -944,7 +944,7 @@ uint8_t *u8g2_m_20_9_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -955,7 +955,7 @@ uint8_t *u8g2_m_20_9_f(uint8_t *page_cnt)
   *page_cnt = 9;
   return 0;
   #else
-  static uint8_t buf[1440];
+  static uint8_t buf[1440] U8G2_BUFFER_ALIGNED;
   *page_cnt = 9;
   return buf;
   #endif
@@ -966,7 +966,7 @@ uint8_t *u8g2_m_11_6_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[88];
+  static uint8_t buf[88] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -977,7 +977,7 @@ uint8_t *u8g2_m_11_6_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[176];
+  static uint8_t buf[176] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -988,7 +988,7 @@ uint8_t *u8g2_m_11_6_f(uint8_t *page_cnt)
   *page_cnt = 6;
   return 0;
   #else
-  static uint8_t buf[528];
+  static uint8_t buf[528] U8G2_BUFFER_ALIGNED;
   *page_cnt = 6;
   return buf;
   #endif
@@ -999,7 +999,7 @@ uint8_t *u8g2_m_12_9_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[96];
+  static uint8_t buf[96] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1010,7 +1010,7 @@ uint8_t *u8g2_m_12_9_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1021,7 +1021,7 @@ uint8_t *u8g2_m_12_9_f(uint8_t *page_cnt)
   *page_cnt = 9;
   return 0;
   #else
-  static uint8_t buf[864];
+  static uint8_t buf[864] U8G2_BUFFER_ALIGNED;
   *page_cnt = 9;
   return buf;
   #endif
@@ -1032,7 +1032,7 @@ uint8_t *u8g2_m_24_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1043,7 +1043,7 @@ uint8_t *u8g2_m_24_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1054,7 +1054,7 @@ uint8_t *u8g2_m_24_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[1536];
+  static uint8_t buf[1536] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -1065,7 +1065,7 @@ uint8_t *u8g2_m_30_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[240];
+  static uint8_t buf[240] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1076,7 +1076,7 @@ uint8_t *u8g2_m_30_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[480];
+  static uint8_t buf[480] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1087,7 +1087,7 @@ uint8_t *u8g2_m_30_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[1920];
+  static uint8_t buf[1920] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -1098,7 +1098,7 @@ uint8_t *u8g2_m_30_15_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[240];
+  static uint8_t buf[240] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1109,7 +1109,7 @@ uint8_t *u8g2_m_30_15_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[480];
+  static uint8_t buf[480] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1120,7 +1120,7 @@ uint8_t *u8g2_m_30_15_f(uint8_t *page_cnt)
   *page_cnt = 15;
   return 0;
   #else
-  static uint8_t buf[3600];
+  static uint8_t buf[3600] U8G2_BUFFER_ALIGNED;
   *page_cnt = 15;
   return buf;
   #endif
@@ -1131,7 +1131,7 @@ uint8_t *u8g2_m_30_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[240];
+  static uint8_t buf[240] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1142,7 +1142,7 @@ uint8_t *u8g2_m_30_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[480];
+  static uint8_t buf[480] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1153,7 +1153,7 @@ uint8_t *u8g2_m_30_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[3840];
+  static uint8_t buf[3840] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -1164,7 +1164,7 @@ uint8_t *u8g2_m_32_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1175,7 +1175,7 @@ uint8_t *u8g2_m_32_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1186,7 +1186,7 @@ uint8_t *u8g2_m_32_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[4096];
+  static uint8_t buf[4096] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -1197,7 +1197,7 @@ uint8_t *u8g2_m_20_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1208,7 +1208,7 @@ uint8_t *u8g2_m_20_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1219,7 +1219,7 @@ uint8_t *u8g2_m_20_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[2560];
+  static uint8_t buf[2560] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -1230,7 +1230,7 @@ uint8_t *u8g2_m_24_12_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[192];
+  static uint8_t buf[192] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1241,7 +1241,7 @@ uint8_t *u8g2_m_24_12_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1252,7 +1252,7 @@ uint8_t *u8g2_m_24_12_f(uint8_t *page_cnt)
   *page_cnt = 12;
   return 0;
   #else
-  static uint8_t buf[2304];
+  static uint8_t buf[2304] U8G2_BUFFER_ALIGNED;
   *page_cnt = 12;
   return buf;
   #endif
@@ -1263,7 +1263,7 @@ uint8_t *u8g2_m_20_13_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1274,7 +1274,7 @@ uint8_t *u8g2_m_20_13_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1285,7 +1285,7 @@ uint8_t *u8g2_m_20_13_f(uint8_t *page_cnt)
   *page_cnt = 13;
   return 0;
   #else
-  static uint8_t buf[2080];
+  static uint8_t buf[2080] U8G2_BUFFER_ALIGNED;
   *page_cnt = 13;
   return buf;
   #endif
@@ -1296,7 +1296,7 @@ uint8_t *u8g2_m_30_20_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[240];
+  static uint8_t buf[240] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1307,7 +1307,7 @@ uint8_t *u8g2_m_30_20_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[480];
+  static uint8_t buf[480] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1318,7 +1318,7 @@ uint8_t *u8g2_m_30_20_f(uint8_t *page_cnt)
   *page_cnt = 20;
   return 0;
   #else
-  static uint8_t buf[4800];
+  static uint8_t buf[4800] U8G2_BUFFER_ALIGNED;
   *page_cnt = 20;
   return buf;
   #endif
@@ -1329,7 +1329,7 @@ uint8_t *u8g2_m_40_30_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1340,7 +1340,7 @@ uint8_t *u8g2_m_40_30_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[640];
+  static uint8_t buf[640] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1351,7 +1351,7 @@ uint8_t *u8g2_m_40_30_f(uint8_t *page_cnt)
   *page_cnt = 30;
   return 0;
   #else
-  static uint8_t buf[9600];
+  static uint8_t buf[9600] U8G2_BUFFER_ALIGNED;
   *page_cnt = 30;
   return buf;
   #endif
@@ -1362,7 +1362,7 @@ uint8_t *u8g2_m_20_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1373,7 +1373,7 @@ uint8_t *u8g2_m_20_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1384,7 +1384,7 @@ uint8_t *u8g2_m_20_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[1280];
+  static uint8_t buf[1280] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -1395,7 +1395,7 @@ uint8_t *u8g2_m_17_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[136];
+  static uint8_t buf[136] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1406,7 +1406,7 @@ uint8_t *u8g2_m_17_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[272];
+  static uint8_t buf[272] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1417,7 +1417,7 @@ uint8_t *u8g2_m_17_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[544];
+  static uint8_t buf[544] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -1428,7 +1428,7 @@ uint8_t *u8g2_m_17_8_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[136];
+  static uint8_t buf[136] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1439,7 +1439,7 @@ uint8_t *u8g2_m_17_8_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[272];
+  static uint8_t buf[272] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1450,7 +1450,7 @@ uint8_t *u8g2_m_17_8_f(uint8_t *page_cnt)
   *page_cnt = 8;
   return 0;
   #else
-  static uint8_t buf[1088];
+  static uint8_t buf[1088] U8G2_BUFFER_ALIGNED;
   *page_cnt = 8;
   return buf;
   #endif
@@ -1461,7 +1461,7 @@ uint8_t *u8g2_m_17_9_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[136];
+  static uint8_t buf[136] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1472,7 +1472,7 @@ uint8_t *u8g2_m_17_9_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[272];
+  static uint8_t buf[272] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1483,7 +1483,7 @@ uint8_t *u8g2_m_17_9_f(uint8_t *page_cnt)
   *page_cnt = 9;
   return 0;
   #else
-  static uint8_t buf[1224];
+  static uint8_t buf[1224] U8G2_BUFFER_ALIGNED;
   *page_cnt = 9;
   return buf;
   #endif
@@ -1494,7 +1494,7 @@ uint8_t *u8g2_m_16_32_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1505,7 +1505,7 @@ uint8_t *u8g2_m_16_32_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1516,7 +1516,7 @@ uint8_t *u8g2_m_16_32_f(uint8_t *page_cnt)
   *page_cnt = 32;
   return 0;
   #else
-  static uint8_t buf[4096];
+  static uint8_t buf[4096] U8G2_BUFFER_ALIGNED;
   *page_cnt = 32;
   return buf;
   #endif
@@ -1527,7 +1527,7 @@ uint8_t *u8g2_m_26_25_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[208];
+  static uint8_t buf[208] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1538,7 +1538,7 @@ uint8_t *u8g2_m_26_25_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[416];
+  static uint8_t buf[416] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1549,7 +1549,7 @@ uint8_t *u8g2_m_26_25_f(uint8_t *page_cnt)
   *page_cnt = 25;
   return 0;
   #else
-  static uint8_t buf[5200];
+  static uint8_t buf[5200] U8G2_BUFFER_ALIGNED;
   *page_cnt = 25;
   return buf;
   #endif
@@ -1560,7 +1560,7 @@ uint8_t *u8g2_m_21_48_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[168];
+  static uint8_t buf[168] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1571,7 +1571,7 @@ uint8_t *u8g2_m_21_48_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[336];
+  static uint8_t buf[336] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1582,7 +1582,7 @@ uint8_t *u8g2_m_21_48_f(uint8_t *page_cnt)
   *page_cnt = 48;
   return 0;
   #else
-  static uint8_t buf[8064];
+  static uint8_t buf[8064] U8G2_BUFFER_ALIGNED;
   *page_cnt = 48;
   return buf;
   #endif
@@ -1593,7 +1593,7 @@ uint8_t *u8g2_m_48_17_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1604,7 +1604,7 @@ uint8_t *u8g2_m_48_17_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[768];
+  static uint8_t buf[768] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1615,7 +1615,7 @@ uint8_t *u8g2_m_48_17_f(uint8_t *page_cnt)
   *page_cnt = 17;
   return 0;
   #else
-  static uint8_t buf[6528];
+  static uint8_t buf[6528] U8G2_BUFFER_ALIGNED;
   *page_cnt = 17;
   return buf;
   #endif
@@ -1626,7 +1626,7 @@ uint8_t *u8g2_m_48_20_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1637,7 +1637,7 @@ uint8_t *u8g2_m_48_20_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[768];
+  static uint8_t buf[768] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1648,7 +1648,7 @@ uint8_t *u8g2_m_48_20_f(uint8_t *page_cnt)
   *page_cnt = 20;
   return 0;
   #else
-  static uint8_t buf[7680];
+  static uint8_t buf[7680] U8G2_BUFFER_ALIGNED;
   *page_cnt = 20;
   return buf;
   #endif
@@ -1659,7 +1659,7 @@ uint8_t *u8g2_m_42_20_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[336];
+  static uint8_t buf[336] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1670,7 +1670,7 @@ uint8_t *u8g2_m_42_20_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[672];
+  static uint8_t buf[672] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1681,7 +1681,7 @@ uint8_t *u8g2_m_42_20_f(uint8_t *page_cnt)
   *page_cnt = 20;
   return 0;
   #else
-  static uint8_t buf[6720];
+  static uint8_t buf[6720] U8G2_BUFFER_ALIGNED;
   *page_cnt = 20;
   return buf;
   #endif
@@ -1692,7 +1692,7 @@ uint8_t *u8g2_m_20_12_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1703,7 +1703,7 @@ uint8_t *u8g2_m_20_12_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1714,7 +1714,7 @@ uint8_t *u8g2_m_20_12_f(uint8_t *page_cnt)
   *page_cnt = 12;
   return 0;
   #else
-  static uint8_t buf[1920];
+  static uint8_t buf[1920] U8G2_BUFFER_ALIGNED;
   *page_cnt = 12;
   return buf;
   #endif
@@ -1725,7 +1725,7 @@ uint8_t *u8g2_m_32_20_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1736,7 +1736,7 @@ uint8_t *u8g2_m_32_20_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1747,7 +1747,7 @@ uint8_t *u8g2_m_32_20_f(uint8_t *page_cnt)
   *page_cnt = 20;
   return 0;
   #else
-  static uint8_t buf[5120];
+  static uint8_t buf[5120] U8G2_BUFFER_ALIGNED;
   *page_cnt = 20;
   return buf;
   #endif
@@ -1758,7 +1758,7 @@ uint8_t *u8g2_m_22_13_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[176];
+  static uint8_t buf[176] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1769,7 +1769,7 @@ uint8_t *u8g2_m_22_13_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[352];
+  static uint8_t buf[352] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1780,7 +1780,7 @@ uint8_t *u8g2_m_22_13_f(uint8_t *page_cnt)
   *page_cnt = 13;
   return 0;
   #else
-  static uint8_t buf[2288];
+  static uint8_t buf[2288] U8G2_BUFFER_ALIGNED;
   *page_cnt = 13;
   return buf;
   #endif
@@ -1791,7 +1791,7 @@ uint8_t *u8g2_m_20_10_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1802,7 +1802,7 @@ uint8_t *u8g2_m_20_10_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1813,7 +1813,7 @@ uint8_t *u8g2_m_20_10_f(uint8_t *page_cnt)
   *page_cnt = 10;
   return 0;
   #else
-  static uint8_t buf[1600];
+  static uint8_t buf[1600] U8G2_BUFFER_ALIGNED;
   *page_cnt = 10;
   return buf;
   #endif
@@ -1824,7 +1824,7 @@ uint8_t *u8g2_m_19_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[152];
+  static uint8_t buf[152] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1835,7 +1835,7 @@ uint8_t *u8g2_m_19_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[304];
+  static uint8_t buf[304] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1846,7 +1846,7 @@ uint8_t *u8g2_m_19_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[608];
+  static uint8_t buf[608] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -1857,7 +1857,7 @@ uint8_t *u8g2_m_16_9_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1868,7 +1868,7 @@ uint8_t *u8g2_m_16_9_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1879,7 +1879,7 @@ uint8_t *u8g2_m_16_9_f(uint8_t *page_cnt)
   *page_cnt = 9;
   return 0;
   #else
-  static uint8_t buf[1152];
+  static uint8_t buf[1152] U8G2_BUFFER_ALIGNED;
   *page_cnt = 9;
   return buf;
   #endif
@@ -1890,7 +1890,7 @@ uint8_t *u8g2_m_20_17_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1901,7 +1901,7 @@ uint8_t *u8g2_m_20_17_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1912,7 +1912,7 @@ uint8_t *u8g2_m_20_17_f(uint8_t *page_cnt)
   *page_cnt = 17;
   return 0;
   #else
-  static uint8_t buf[2720];
+  static uint8_t buf[2720] U8G2_BUFFER_ALIGNED;
   *page_cnt = 17;
   return buf;
   #endif
@@ -1923,7 +1923,7 @@ uint8_t *u8g2_m_26_5_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[208];
+  static uint8_t buf[208] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1934,7 +1934,7 @@ uint8_t *u8g2_m_26_5_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[416];
+  static uint8_t buf[416] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1945,7 +1945,7 @@ uint8_t *u8g2_m_26_5_f(uint8_t *page_cnt)
   *page_cnt = 5;
   return 0;
   #else
-  static uint8_t buf[1040];
+  static uint8_t buf[1040] U8G2_BUFFER_ALIGNED;
   *page_cnt = 5;
   return buf;
   #endif
@@ -1956,7 +1956,7 @@ uint8_t *u8g2_m_22_9_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[176];
+  static uint8_t buf[176] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -1967,7 +1967,7 @@ uint8_t *u8g2_m_22_9_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[352];
+  static uint8_t buf[352] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -1978,7 +1978,7 @@ uint8_t *u8g2_m_22_9_f(uint8_t *page_cnt)
   *page_cnt = 9;
   return 0;
   #else
-  static uint8_t buf[1584];
+  static uint8_t buf[1584] U8G2_BUFFER_ALIGNED;
   *page_cnt = 9;
   return buf;
   #endif
@@ -1989,7 +1989,7 @@ uint8_t *u8g2_m_25_25_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[200];
+  static uint8_t buf[200] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2000,7 +2000,7 @@ uint8_t *u8g2_m_25_25_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[400];
+  static uint8_t buf[400] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2011,7 +2011,7 @@ uint8_t *u8g2_m_25_25_f(uint8_t *page_cnt)
   *page_cnt = 25;
   return 0;
   #else
-  static uint8_t buf[5000];
+  static uint8_t buf[5000] U8G2_BUFFER_ALIGNED;
   *page_cnt = 25;
   return buf;
   #endif
@@ -2022,7 +2022,7 @@ uint8_t *u8g2_m_37_16_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[296];
+  static uint8_t buf[296] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2033,7 +2033,7 @@ uint8_t *u8g2_m_37_16_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[592];
+  static uint8_t buf[592] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2044,7 +2044,7 @@ uint8_t *u8g2_m_37_16_f(uint8_t *page_cnt)
   *page_cnt = 16;
   return 0;
   #else
-  static uint8_t buf[4736];
+  static uint8_t buf[4736] U8G2_BUFFER_ALIGNED;
   *page_cnt = 16;
   return buf;
   #endif
@@ -2055,7 +2055,7 @@ uint8_t *u8g2_m_40_25_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2066,7 +2066,7 @@ uint8_t *u8g2_m_40_25_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[640];
+  static uint8_t buf[640] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2077,7 +2077,7 @@ uint8_t *u8g2_m_40_25_f(uint8_t *page_cnt)
   *page_cnt = 25;
   return 0;
   #else
-  static uint8_t buf[8000];
+  static uint8_t buf[8000] U8G2_BUFFER_ALIGNED;
   *page_cnt = 25;
   return buf;
   #endif
@@ -2088,7 +2088,7 @@ uint8_t *u8g2_m_8_1_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[64];
+  static uint8_t buf[64] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2099,7 +2099,7 @@ uint8_t *u8g2_m_8_1_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[128];
+  static uint8_t buf[128] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2110,7 +2110,7 @@ uint8_t *u8g2_m_8_1_f(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[64];
+  static uint8_t buf[64] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2121,7 +2121,7 @@ uint8_t *u8g2_m_4_1_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[32];
+  static uint8_t buf[32] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2132,7 +2132,7 @@ uint8_t *u8g2_m_4_1_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[64];
+  static uint8_t buf[64] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2143,7 +2143,7 @@ uint8_t *u8g2_m_4_1_f(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[32];
+  static uint8_t buf[32] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2154,7 +2154,7 @@ uint8_t *u8g2_m_1_1_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[8];
+  static uint8_t buf[8] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2165,7 +2165,7 @@ uint8_t *u8g2_m_1_1_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[16];
+  static uint8_t buf[16] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2176,7 +2176,7 @@ uint8_t *u8g2_m_1_1_f(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[8];
+  static uint8_t buf[8] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2187,7 +2187,7 @@ uint8_t *u8g2_m_13_4_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[104];
+  static uint8_t buf[104] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2198,7 +2198,7 @@ uint8_t *u8g2_m_13_4_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[208];
+  static uint8_t buf[208] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2209,7 +2209,7 @@ uint8_t *u8g2_m_13_4_f(uint8_t *page_cnt)
   *page_cnt = 4;
   return 0;
   #else
-  static uint8_t buf[416];
+  static uint8_t buf[416] U8G2_BUFFER_ALIGNED;
   *page_cnt = 4;
   return buf;
   #endif
@@ -2220,7 +2220,7 @@ uint8_t *u8g2_m_20_2_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[160];
+  static uint8_t buf[160] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2231,7 +2231,7 @@ uint8_t *u8g2_m_20_2_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2242,7 +2242,7 @@ uint8_t *u8g2_m_20_2_f(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[320];
+  static uint8_t buf[320] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2253,7 +2253,7 @@ uint8_t *u8g2_m_32_7_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2264,7 +2264,7 @@ uint8_t *u8g2_m_32_7_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2275,7 +2275,7 @@ uint8_t *u8g2_m_32_7_f(uint8_t *page_cnt)
   *page_cnt = 7;
   return 0;
   #else
-  static uint8_t buf[1792];
+  static uint8_t buf[1792] U8G2_BUFFER_ALIGNED;
   *page_cnt = 7;
   return buf;
   #endif
@@ -2286,7 +2286,7 @@ uint8_t *u8g2_m_32_6_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[256];
+  static uint8_t buf[256] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2297,7 +2297,7 @@ uint8_t *u8g2_m_32_6_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[512];
+  static uint8_t buf[512] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2308,7 +2308,7 @@ uint8_t *u8g2_m_32_6_f(uint8_t *page_cnt)
   *page_cnt = 6;
   return 0;
   #else
-  static uint8_t buf[1536];
+  static uint8_t buf[1536] U8G2_BUFFER_ALIGNED;
   *page_cnt = 6;
   return buf;
   #endif
@@ -2319,7 +2319,7 @@ uint8_t *u8g2_m_48_30_1(uint8_t *page_cnt)
   *page_cnt = 1;
   return 0;
   #else
-  static uint8_t buf[384];
+  static uint8_t buf[384] U8G2_BUFFER_ALIGNED;
   *page_cnt = 1;
   return buf;
   #endif
@@ -2330,7 +2330,7 @@ uint8_t *u8g2_m_48_30_2(uint8_t *page_cnt)
   *page_cnt = 2;
   return 0;
   #else
-  static uint8_t buf[768];
+  static uint8_t buf[768] U8G2_BUFFER_ALIGNED;
   *page_cnt = 2;
   return buf;
   #endif
@@ -2341,7 +2341,7 @@ uint8_t *u8g2_m_48_30_f(uint8_t *page_cnt)
   *page_cnt = 30;
   return 0;
   #else
-  static uint8_t buf[11520];
+  static uint8_t buf[11520] U8G2_BUFFER_ALIGNED;
   *page_cnt = 30;
   return buf;
   #endif
@@ -0,0 +1,174 @@
+/*
+
+  u8g2_epd.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  Refresh manager for e-paper displays (full buffer mode only)
+
+  u8g2_epd_SendBuffer() replaces u8g2_SendBuffer(). The buffer is compared
+  against a shadow copy of the last frame. Only the changed tiles of each
+  tile row are written to the display RAM and a partial refresh is
+  executed (U8X8_MSG_DISPLAY_REFRESH_PARTIAL).
+  A full refresh is done instead
+    - for the first frame and after u8g2_epd_ForceFullRefresh()
+    - after max_partial partial refreshes
+    - if more than max_changed_tiles tiles were changed since the last
+      full refresh (ghosting threshold)
+    - if the display does not support a partial refresh
+
+  The IL3820 and SSD1607 toggle between two RAM areas with each refresh.
+  The partial waveform compares both RAM areas, so the changed tiles are
+  written again after the refresh, to keep both areas identical.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+/*
+  shadow: Memory for the copy of the last frame, u8g2_GetBufferSize() bytes.
+  max_partial: Number of partial refreshes before a full refresh is forced, 0: no limit
+  max_changed_tiles: Full refresh, if more tiles were changed since the last full refresh, 0: no limit
+*/
+void u8g2_epd_Init(u8g2_epd_t *epd, uint8_t *shadow, uint8_t max_partial, uint16_t max_changed_tiles)
+{
+  epd->shadow = shadow;
+  epd->max_partial = max_partial;
+  epd->max_changed_tiles = max_changed_tiles;
+  epd->partial_cnt = 0;
+  epd->changed_tiles = 0;
+  epd->is_full_refresh_required = 1;	/* content of the display is not known */
+}
+
+/* returns the number of changed tiles in the tile row, first and last changed tile are stored in tx0 and tx1 */
+static uint8_t u8g2_epd_get_row_diff(u8g2_t *u8g2, u8g2_epd_t *epd, uint8_t ty, uint8_t *tx0, uint8_t *tx1)
+{
+  uint8_t *buf;
+  uint8_t *shadow;
+  uint8_t tx, tw;
+  uint8_t cnt = 0;
+
+  tw = u8g2_GetBufferTileWidth(u8g2);
+  buf = u8g2_GetBufferPtr(u8g2) + (uint16_t)ty * u8g2->pixel_buf_width;
+  shadow = epd->shadow + (uint16_t)ty * u8g2->pixel_buf_width;
+  for( tx = 0; tx < tw; tx++ )
+  {
+    if ( memcmp(buf, shadow, 8) != 0 )
+    {
+      if ( cnt == 0 )
+	*tx0 = tx;
+      *tx1 = tx;
+      cnt++;
+    }
+    buf += 8;
+    shadow += 8;
+  }
+  return cnt;
+}
+
+/* write the changed tiles to the display RAM, if is_update_shadow is not 0, also copy them to the shadow buffer */
+static void u8g2_epd_send_changed_tiles(u8g2_t *u8g2, u8g2_epd_t *epd, uint8_t is_update_shadow)
+{
+  uint8_t ty, tx0, tx1;
+  uint16_t offset;
+
+  for( ty = 0; ty < u8g2_GetBufferTileHeight(u8g2); ty++ )
+  {
+    if ( u8g2_epd_get_row_diff(u8g2, epd, ty, &tx0, &tx1) > 0 )
+    {
+      u8g2_UpdateDisplayArea(u8g2, tx0, ty, tx1-tx0+1, 1);
+      if ( is_update_shadow )
+      {
+	offset = (uint16_t)ty * u8g2->pixel_buf_width + tx0*8;
+	memcpy(epd->shadow + offset, u8g2_GetBufferPtr(u8g2) + offset, (tx1-tx0+1)*8);
+      }
+    }
+  }
+}
+
+static void u8g2_epd_full_refresh(u8g2_t *u8g2, u8g2_epd_t *epd)
+{
+  u8g2_UpdateDisplay(u8g2);
+  u8x8_RefreshDisplay(u8g2_GetU8x8(u8g2));
+  u8g2_UpdateDisplay(u8g2);		/* second RAM area */
+  memcpy(epd->shadow, u8g2_GetBufferPtr(u8g2), u8g2_GetBufferSize(u8g2));
+  epd->partial_cnt = 0;
+  epd->changed_tiles = 0;
+  epd->is_full_refresh_required = 0;
+}
+
+/*
+  Send the buffer to the display and make it visible.
+  Returns:
+    0: nothing has changed, nothing was sent
+    1: partial refresh
+    2: full refresh
+*/
+uint8_t u8g2_epd_SendBuffer(u8g2_t *u8g2, u8g2_epd_t *epd)
+{
+  uint8_t ty, tx0, tx1;
+  uint16_t cnt = 0;
+
+  /* check, whether we are in full buffer mode */
+  if ( u8g2->tile_buf_height != u8g2_GetU8x8(u8g2)->display_info->tile_height )
+  {
+    u8g2_SendBuffer(u8g2);
+    return 2;
+  }
+
+  if ( epd->is_full_refresh_required == 0 )
+  {
+    for( ty = 0; ty < u8g2_GetBufferTileHeight(u8g2); ty++ )
+      cnt += u8g2_epd_get_row_diff(u8g2, epd, ty, &tx0, &tx1);
+    if ( cnt == 0 )
+      return 0;
+
+    cnt += epd->changed_tiles;
+    if ( epd->max_partial == 0 || epd->partial_cnt < epd->max_partial )
+    {
+      if ( epd->max_changed_tiles == 0 || cnt <= epd->max_changed_tiles )
+      {
+	u8g2_epd_send_changed_tiles(u8g2, epd, 0);
+	if ( u8x8_RefreshDisplayPartial(u8g2_GetU8x8(u8g2)) != 0 )
+	{
+	  u8g2_epd_send_changed_tiles(u8g2, epd, 1);		/* second RAM area */
+	  epd->partial_cnt++;
+	  epd->changed_tiles = cnt;
+	  return 1;
+	}
+	/* partial refresh is not supported, the full refresh below will send everything again */
+      }
+    }
+  }
+
+  u8g2_epd_full_refresh(u8g2, epd);
+  return 2;
+}
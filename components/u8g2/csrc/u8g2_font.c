@@ -575,6 +575,84 @@ void u8g2_font_2x_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
 }
 
 
+/*
+  Description:
+    Draw a run length encoded line of a glyph, scaled by u8g2->font_decode.scale.
+    Each run becomes one box of current*scale x scale pixel.
+    Font rotation is not supported.
+  Called by:
+    u8g2_font_scaled_decode_glyph()
+*/
+void u8g2_font_scaled_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
+{
+  uint8_t cnt;	/* total number of remaining pixels, which have to be drawn */
+  uint8_t rem; 	/* remaining pixel to the right edge of the glyph */
+  uint8_t current;	/* number of pixels, which need to be drawn for the draw procedure */
+  uint8_t scale;
+  
+  /* local coordinates of the glyph */
+  uint8_t lx,ly;
+  
+  /* target position on the screen */
+  u8g2_uint_t x, y;
+  
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  
+  cnt = len;
+  scale = decode->scale;
+  
+  /* get the local position */
+  lx = decode->x;
+  ly = decode->y;
+  
+  for(;;)
+  {
+    /* calculate the number of pixel to the right edge of the glyph */
+    rem = decode->glyph_width;
+    rem -= lx;
+    
+    /* calculate how many pixel to draw. This is either to the right edge */
+    /* or lesser, if not enough pixel are left */
+    current = rem;
+    if ( cnt < rem )
+      current = cnt;
+    
+    if ( current > 0 )
+    {
+      /* get target position */
+      x = decode->target_x;
+      y = decode->target_y;
+
+      x += (u8g2_uint_t)lx*scale;
+      y += (u8g2_uint_t)ly*scale;
+      
+      /* draw foreground and background (if required) */
+      if ( is_foreground )
+      {
+	u8g2->draw_color = decode->fg_color;			/* draw_color will be restored later */
+	u8g2_DrawBox(u8g2, x, y, (u8g2_uint_t)current*scale, scale);
+      }
+      else if ( decode->is_transparent == 0 )    
+      {
+	u8g2->draw_color = decode->bg_color;			/* draw_color will be restored later */
+	u8g2_DrawBox(u8g2, x, y, (u8g2_uint_t)current*scale, scale);
+      }
+    }
+    
+    /* check, whether the end of the run length code has been reached */
+    if ( cnt < rem )
+      break;
+    cnt -= rem;
+    lx = 0;
+    ly++;
+  }
+  lx += cnt;
+  
+  decode->x = lx;
+  decode->y = ly;
+}
+
+
 static void u8g2_font_setup_decode(u8g2_t *u8g2, const uint8_t *glyph_data)
 {
   u8g2_font_decode_t *decode = &(u8g2->font_decode);
@@ -771,6 +849,77 @@ int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   return d*2;
 }
 
+/*
+  Description:
+    Decode and draw a glyph, scaled by u8g2->font_decode.scale.
+    Unlike u8g2_font_2x_decode_glyph(), the glyph offsets are also scaled, so the 
+    result is identical to an upscaled version of u8g2_font_decode_glyph().
+  Return:
+    Scaled width (delta x advance) of the glyph.
+*/
+u8g2_uint_t u8g2_font_scaled_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
+{
+  uint8_t a, b;
+  int8_t x, y;
+  int8_t d;
+  int8_t h;
+  uint8_t scale;
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+    
+  u8g2_font_setup_decode(u8g2, glyph_data);     /* set values in u8g2->font_decode data structure */
+  h = u8g2->font_decode.glyph_height;
+  scale = decode->scale;
+  
+  x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  
+  if ( decode->glyph_width > 0 )
+  {
+    decode->target_x += (int16_t)x*scale;
+    decode->target_y -= (int16_t)(h+y)*scale;
+
+#ifdef U8G2_WITH_INTERSECTION
+    {
+      u8g2_uint_t x0, x1, y0, y1;
+      x0 = decode->target_x;
+      y0 = decode->target_y;
+      x1 = x0;
+      y1 = y0;
+      
+      x1 += (u8g2_uint_t)decode->glyph_width*scale;
+      y1 += (u8g2_uint_t)h*scale;
+      
+      if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0 ) 
+	return (u8g2_uint_t)d*scale;
+    }
+#endif /* U8G2_WITH_INTERSECTION */
+   
+    /* reset local x/y position */
+    decode->x = 0;
+    decode->y = 0;
+    
+    /* decode glyph */
+    for(;;)
+    {
+      a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+      b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+      do
+      {
+	u8g2_font_scaled_decode_len(u8g2, a, 0);
+	u8g2_font_scaled_decode_len(u8g2, b, 1);
+      } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+      if ( decode->y >= h )
+	break;
+    }
+    
+    /* restore the u8g2 draw color, because this is modified by the decode algo */
+    u8g2->draw_color = decode->fg_color;
+  }
+  return (u8g2_uint_t)d*scale;
+}
+
 /*
   Description:
     Find the starting point of the glyph data.
@@ -895,6 +1044,20 @@ static u8g2_uint_t u8g2_font_2x_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uin
 }
 
 
+static u8g2_uint_t u8g2_font_scaled_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, uint16_t encoding)
+{
+  u8g2_uint_t dx = 0;
+  u8g2->font_decode.target_x = x;
+  u8g2->font_decode.target_y = y;
+  u8g2->font_decode.scale = scale;
+  const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
+  if ( glyph_data != NULL )
+  {
+    dx = u8g2_font_scaled_decode_glyph(u8g2, glyph_data);
+  }
+  return dx;
+}
+
 
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding)
 {
@@ -963,11 +1126,22 @@ u8g2_uint_t u8g2_DrawGlyphX2(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_
   return u8g2_font_2x_draw_glyph(u8g2, x, y, encoding);
 }
 
+/*
+  Draw a glyph, upscaled by an integer factor (1..). The font direction is ignored.
+  Returns the scaled delta x advance of the glyph.
+*/
+u8g2_uint_t u8g2_DrawGlyphScaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, uint16_t encoding)
+{
+  y += (u8g2_uint_t)scale*u8g2->font_calc_vref(u8g2);
+  return u8g2_font_scaled_draw_glyph(u8g2, x, y, scale, encoding);
+}
+
 static u8g2_uint_t u8g2_draw_string(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str) U8G2_NOINLINE;
 static u8g2_uint_t u8g2_draw_string(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str)
 {
   uint16_t e;
   u8g2_uint_t delta, sum;
+  U8X8_TIMING_BEGIN(u8g2_GetU8x8(u8g2));
   u8x8_utf8_init(u8g2_GetU8x8(u8g2));
   sum = 0;
   for(;;)
@@ -1010,6 +1184,7 @@ static u8g2_uint_t u8g2_draw_string(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
       sum += delta;    
     }
   }
+  U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_FONT, 0);
   return sum;
 }
 
@@ -1018,6 +1193,7 @@ static u8g2_uint_t u8g2_draw_string_2x(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
 {
   uint16_t e;
   u8g2_uint_t delta, sum;
+  U8X8_TIMING_BEGIN(u8g2_GetU8x8(u8g2));
   u8x8_utf8_init(u8g2_GetU8x8(u8g2));
   sum = 0;
   for(;;)
@@ -1033,6 +1209,32 @@ static u8g2_uint_t u8g2_draw_string_2x(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
       sum += delta;    
     }
   }
+  U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_FONT, 0);
+  return sum;
+}
+
+static u8g2_uint_t u8g2_draw_string_scaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *str) U8G2_NOINLINE;
+static u8g2_uint_t u8g2_draw_string_scaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *str)
+{
+  uint16_t e;
+  u8g2_uint_t delta, sum;
+  U8X8_TIMING_BEGIN(u8g2_GetU8x8(u8g2));
+  u8x8_utf8_init(u8g2_GetU8x8(u8g2));
+  sum = 0;
+  for(;;)
+  {
+    e = u8g2->u8x8.next_cb(u8g2_GetU8x8(u8g2), (uint8_t)*str);
+    if ( e == 0x0ffff )
+      break;
+    str++;
+    if ( e != 0x0fffe )
+    {
+      delta = u8g2_DrawGlyphScaled(u8g2, x, y, scale, e);
+      x += delta;
+      sum += delta;    
+    }
+  }
+  U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_FONT, 0);
   return sum;
 }
 
@@ -1070,6 +1272,18 @@ u8g2_uint_t u8g2_DrawUTF8X2(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const ch
   return u8g2_draw_string_2x(u8g2, x, y, str);
 }
 
+u8g2_uint_t u8g2_DrawStrScaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *str)
+{
+  u8g2->u8x8.next_cb = u8x8_ascii_next;
+  return u8g2_draw_string_scaled(u8g2, x, y, scale, str);
+}
+
+u8g2_uint_t u8g2_DrawUTF8Scaled(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t scale, const char *str)
+{
+  u8g2->u8x8.next_cb = u8x8_utf8_next;
+  return u8g2_draw_string_scaled(u8g2, x, y, scale, str);
+}
+
 
 u8g2_uint_t u8g2_DrawExtendedUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t to_left, u8g2_kerning_t *kerning, const char *str)
 {
@@ -1551,6 +1765,280 @@ u8g2_uint_t u8g2_GetUTF8Width(u8g2_t *u8g2, const char *str)
   return u8g2_string_width(u8g2, str);
 }
 
+/*===============================================*/
+/* string runs */
+
+/* 
+  resolve all glyphs of str, the calculation of the width is identical to u8g2_string_width() 
+  returns 0 if the glyph array was too small, in this case the run is still valid, but u8g2_DrawStrRun() will use the string
+*/
+static uint8_t u8g2_layout_string(u8g2_t *u8g2, u8g2_str_run_t *run, u8g2_str_glyph_t *glyph, uint8_t max, const char *str) U8G2_NOINLINE;
+static uint8_t u8g2_layout_string(u8g2_t *u8g2, u8g2_str_run_t *run, u8g2_str_glyph_t *glyph, uint8_t max, const char *str)
+{
+  const uint8_t *glyph_data;
+  uint16_t e;
+  u8g2_uint_t w;
+  int8_t dx, y, h;
+  uint16_t cnt = 0;
+#ifdef U8G2_BALANCED_STR_WIDTH_CALCULATION
+  int8_t initial_x_offset = -64;
+#endif 
+  
+  if ( max > 254 )
+    max = 254;	/* run->cnt must be able to indicate an overflow */
+  run->font = u8g2->font;
+  run->str = str;
+  run->glyph = glyph;
+  run->max = max;
+  run->x_offset = 0;
+  run->ascent = 0;
+  run->descent = 0;
+  
+  u8g2->font_decode.glyph_width = 0;
+  u8x8_utf8_init(u8g2_GetU8x8(u8g2));
+  w = 0;
+  dx = 0;
+  for(;;)
+  {
+    e = u8g2->u8x8.next_cb(u8g2_GetU8x8(u8g2), (uint8_t)*str);
+    if ( e == 0x0ffff )
+      break;
+    str++;
+    if ( e != 0x0fffe )
+    {
+      dx = 0;
+      glyph_data = u8g2_font_get_glyph_data(u8g2, e);
+      if ( glyph_data != NULL )
+      {
+        /* same as u8g2_GetGlyphWidth(), but keep the y offset for the bounding box */
+        u8g2_font_setup_decode(u8g2, glyph_data);
+        u8g2->glyph_x_offset = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_x);
+        y = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_y);
+        dx = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_delta_x);
+        h = u8g2->font_decode.glyph_height;
+        if ( cnt == 0 )
+          run->x_offset = u8g2->glyph_x_offset;
+        if ( h > 0 )
+        {
+          if ( run->ascent < h + y )
+            run->ascent = h + y;
+          if ( run->descent > y )
+            run->descent = y;
+        }
+      }
+#ifdef U8G2_BALANCED_STR_WIDTH_CALCULATION
+      if ( initial_x_offset == -64 )
+        initial_x_offset = u8g2->glyph_x_offset;
+#endif 
+      if ( cnt < max )
+      {
+        glyph[cnt].glyph_data = glyph_data;
+        glyph[cnt].dx = dx;
+      }
+      if ( cnt < 255 )
+        cnt++;
+      w += dx;
+    }
+  }
+  
+  /* adjust the last glyph, see u8g2_string_width() */
+  if ( u8g2->font_decode.glyph_width != 0 )
+  {
+    w -= dx;
+    w += u8g2->font_decode.glyph_width;
+    w += u8g2->glyph_x_offset;
+#ifdef U8G2_BALANCED_STR_WIDTH_CALCULATION
+    if ( initial_x_offset > 0 )
+      w+=initial_x_offset;
+#endif 
+  }
+  run->cnt = cnt;
+  run->width = w;
+  return cnt <= max;
+}
+
+/*
+  Resolve the glyphs of a string for the current font. 
+  "glyph" is a caller supplied array with "max" elements. The string must not be changed as long as the run is used.
+  Returns 0 if the string has more glyphs than "max": The width is still correct, but u8g2_DrawStrRun() will 
+  lookup the glyphs again.
+*/
+uint8_t u8g2_LayoutStr(u8g2_t *u8g2, u8g2_str_run_t *run, u8g2_str_glyph_t *glyph, uint8_t max, const char *str)
+{
+  u8g2->u8x8.next_cb = u8x8_ascii_next;
+  run->is_utf8 = 0;
+  return u8g2_layout_string(u8g2, run, glyph, max, str);
+}
+
+uint8_t u8g2_LayoutUTF8(u8g2_t *u8g2, u8g2_str_run_t *run, u8g2_str_glyph_t *glyph, uint8_t max, const char *str)
+{
+  u8g2->u8x8.next_cb = u8x8_utf8_next;
+  run->is_utf8 = 1;
+  return u8g2_layout_string(u8g2, run, glyph, max, str);
+}
+
+/* same as u8g2_DrawStr() or u8g2_DrawUTF8(), but without glyph lookup */
+u8g2_uint_t u8g2_DrawStrRun(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const u8g2_str_run_t *run)
+{
+  u8g2_uint_t delta, sum;
+  uint8_t i;
+  
+  if ( run->font != u8g2->font || run->cnt > run->max )
+  {
+    /* font has been changed or the run is incomplete */
+    if ( run->is_utf8 )
+      return u8g2_DrawUTF8(u8g2, x, y, run->str);
+    return u8g2_DrawStr(u8g2, x, y, run->str);
+  }
+  
+  U8X8_TIMING_BEGIN(u8g2_GetU8x8(u8g2));
+#ifdef U8G2_WITH_FONT_ROTATION
+  switch(u8g2->font_decode.dir)
+  {
+    case 0:
+      y += u8g2->font_calc_vref(u8g2);
+      break;
+    case 1:
+      x -= u8g2->font_calc_vref(u8g2);
+      break;
+    case 2:
+      y -= u8g2->font_calc_vref(u8g2);
+      break;
+    case 3:
+      x += u8g2->font_calc_vref(u8g2);
+      break;
+  }
+#else
+  y += u8g2->font_calc_vref(u8g2);
+#endif
+
+  sum = 0;
+  for( i = 0; i < run->cnt; i++ )
+  {
+    if ( run->glyph[i].glyph_data == NULL )
+      continue;
+    u8g2->font_decode.target_x = x;
+    u8g2->font_decode.target_y = y;
+    delta = u8g2_font_decode_glyph(u8g2, run->glyph[i].glyph_data);
+#ifdef U8G2_WITH_FONT_ROTATION
+    switch(u8g2->font_decode.dir)
+    {
+      case 0:
+        x += delta;
+        break;
+      case 1:
+        y += delta;
+        break;
+      case 2:
+        x -= delta;
+        break;
+      case 3:
+        y -= delta;
+        break;
+    }
+#else
+    x += delta;
+#endif
+    sum += delta;
+  }
+  U8X8_TIMING_END(u8g2_GetU8x8(u8g2), U8X8_TIMING_FONT, 0);
+  return sum;
+}
+
+/* draw the run left aligned, centered or right aligned within x and x+w-1 */
+u8g2_uint_t u8g2_DrawStrRunAligned(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, uint8_t align, const u8g2_str_run_t *run)
+{
+  if ( run->width < w )
+  {
+    if ( align == U8G2_ALIGN_CENTER )
+      x += (w - run->width)/2;
+    else if ( align == U8G2_ALIGN_RIGHT )
+      x += w - run->width;
+  }
+  return u8g2_DrawStrRun(u8g2, x, y, run);
+}
+
+/*===============================================*/
+/* string width cache */
+
+void u8g2_ClearStrWidthCache(u8g2_str_width_cache_t *cache)
+{
+  uint8_t i;
+  for( i = 0; i < U8G2_STR_WIDTH_CACHE_CNT; i++ )
+    cache->entry[i].font = NULL;
+  cache->next = 0;
+}
+
+/* returns 1 if s is equal to the string of the entry */
+static uint8_t u8g2_str_width_entry_is_equal(const u8g2_str_width_entry_t *entry, const char *s)
+{
+  const char *t = entry->str;
+  for(;;)
+  {
+    if ( *t != *s )
+      return 0;
+    if ( *t == '\0' )
+      return 1;
+    t++;
+    s++;
+  }
+}
+
+static u8g2_uint_t u8g2_get_str_width_cached(u8g2_t *u8g2, u8g2_str_width_cache_t *cache, const char *s, uint8_t is_utf8)
+{
+  u8g2_str_width_entry_t *entry;
+  u8g2_uint_t w;
+  uint8_t i;
+  
+  for( i = 0; i < U8G2_STR_WIDTH_CACHE_CNT; i++ )
+  {
+    entry = cache->entry+i;
+    if ( entry->font == u8g2->font && entry->is_utf8 == is_utf8 && u8g2_str_width_entry_is_equal(entry, s) )
+      return entry->width;
+  }
+  
+  if ( is_utf8 )
+    w = u8g2_GetUTF8Width(u8g2, s);
+  else
+    w = u8g2_GetStrWidth(u8g2, s);
+  
+  for( i = 0; i <= U8G2_STR_WIDTH_CACHE_LEN; i++ )
+    if ( s[i] == '\0' )
+      break;
+  if ( i > U8G2_STR_WIDTH_CACHE_LEN )
+    return w;	/* string is too long for the cache */
+  
+  entry = cache->entry + cache->next;
+  cache->next++;
+  if ( cache->next >= U8G2_STR_WIDTH_CACHE_CNT )
+    cache->next = 0;
+  entry->font = u8g2->font;
+  entry->width = w;
+  entry->is_utf8 = is_utf8;
+  for( i = 0; i <= U8G2_STR_WIDTH_CACHE_LEN; i++ )
+  {
+    entry->str[i] = s[i];
+    if ( s[i] == '\0' )
+      break;
+  }
+  return w;
+}
+
+/*
+  Same as u8g2_GetStrWidth(), but keeps the width of the last U8G2_STR_WIDTH_CACHE_CNT strings
+  of up to U8G2_STR_WIDTH_CACHE_LEN chars together with the font.
+  The cache must be cleared with u8g2_ClearStrWidthCache() before first use (or be a zero initialized global variable).
+*/
+u8g2_uint_t u8g2_GetStrWidthCached(u8g2_t *u8g2, u8g2_str_width_cache_t *cache, const char *s)
+{
+  return u8g2_get_str_width_cached(u8g2, cache, s, 0);
+}
+
+u8g2_uint_t u8g2_GetUTF8WidthCached(u8g2_t *u8g2, u8g2_str_width_cache_t *cache, const char *s)
+{
+  return u8g2_get_str_width_cached(u8g2, cache, s, 1);
+}
+
 
 
 void u8g2_SetFontDirection(u8g2_t *u8g2, uint8_t dir)
@@ -43,6 +43,25 @@ uint8_t u8g2_GetNullKerning(u8g2_t *u8g2, uint16_t e1, uint16_t e2)
 }
 */
 
+/* 
+  binary search in a sorted array with "stride" uint16_t values per entry,
+  returns the position of the first entry which is not less than e (cnt if there is no such entry)
+*/
+static uint16_t u8g2_kerning_lower_bound(const uint16_t *a, uint16_t cnt, uint8_t stride, uint16_t e)
+{
+  uint16_t lo = 0;
+  uint16_t mid;
+  while( lo < cnt )
+  {
+    mid = lo + (cnt-lo)/2;
+    if ( a[mid*stride] < e )
+      lo = mid+1;
+    else
+      cnt = mid;
+  }
+  return lo;
+}
+
 /* this function is used as "u8g2_get_kerning_cb" */
 uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint16_t e1, uint16_t e2)
 {
@@ -50,9 +69,23 @@ uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint1
   if ( kerning == NULL )
     return 0;
   
-  /* search for the encoding in the first table */
   cnt = kerning->first_table_cnt;
   cnt--;	/* ignore the last element of the table, which is 0x0ffff */
+  
+  if ( kerning->flags & U8G2_KERNING_SORTED )
+  {
+    i1 = u8g2_kerning_lower_bound(kerning->first_encoding_table, cnt, 1, e1);
+    if ( i1 >= cnt || kerning->first_encoding_table[i1] != e1 )
+      return 0;
+    i2 = kerning->index_to_second_table[i1];
+    end = kerning->index_to_second_table[i1+1];
+    i2 += u8g2_kerning_lower_bound(kerning->second_encoding_table+i2, end-i2, 1, e2);
+    if ( i2 >= end || kerning->second_encoding_table[i2] != e2 )
+      return 0;
+    return kerning->kerning_values[i2];
+  }
+  
+  /* search for the encoding in the first table */
   for( i1 = 0; i1 < cnt; i1++ )
   {
     if ( kerning->first_encoding_table[i1] == e1 )
@@ -77,10 +110,26 @@ uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint1
 
 uint8_t u8g2_GetKerningByTable(U8X8_UNUSED u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, uint16_t e2)
 {
-  uint16_t i;
+  uint16_t i, end;
   i = 0;
   if ( kt == NULL )
     return 0;
+  
+  if ( kt[0] == U8G2_KERNING_TABLE_INDEXED )
+  {
+    const uint16_t *first = kt+2;
+    const uint16_t *pairs = first + 2*(kt[1]+1);
+    i = u8g2_kerning_lower_bound(first, kt[1], 2, e1);
+    if ( i >= kt[1] || first[2*i] != e1 )
+      return 0;
+    end = first[2*i+3];
+    i = first[2*i+1];
+    i += u8g2_kerning_lower_bound(pairs+2*i, end-i, 2, e2);
+    if ( i >= end || pairs[2*i] != e2 )
+      return 0;
+    return pairs[2*i+1];
+  }
+  
   for(;;)
   {
     if ( kt[i] == 0x0ffff )
@@ -79,6 +79,9 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   
   u8g2->tile_buf_ptr = buf;
   u8g2->tile_buf_height = tile_buf_height;
+  u8g2->buf_list = NULL;
+  u8g2->buf_cnt = 0;
+  u8g2->buf_idx = 0;
   
   u8g2->tile_curr_row = 0;
   
@@ -459,7 +462,7 @@ const u8g2_cb_t u8g2_cb_mirror_vertical = { u8g2_update_dimension_r0, u8g2_updat
 /* setup for the null (empty) device */
 void u8g2_Setup_null(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
 {
-  static uint8_t buf[8];
+  static uint8_t buf[8] U8G2_BUFFER_ALIGNED;
   u8g2_SetupDisplay(u8g2, u8x8_d_null_cb, u8x8_cad_empty, byte_cb, gpio_and_delay_cb);
   u8g2_SetupBuffer(u8g2, buf, 1, u8g2_ll_hvline_vertical_top_lsb, rotation);
 }
@@ -50,39 +50,83 @@ static uint8_t u8log_is_on_screen(u8log_t *u8log, uint8_t x, uint8_t y)
 }
 */
 
-static void u8log_clear_screen(u8log_t *u8log)
+/*
+  The screen_buffer is a ring buffer: Line y of the display is stored 
+  in line (head+y) mod height of the screen_buffer. Scrolling up will 
+  just clear the first line and increment head.
+*/
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y)
+{
+  uint16_t line = u8log->head;
+  line += y;
+  if ( line >= u8log->height )
+    line -= u8log->height;
+  line *= u8log->width;
+  return u8log->screen_buffer + line;
+}
+
+/* returns 1, if line y of the display must be redrawn by the callback */
+uint8_t u8log_IsLineDirty(u8log_t *u8log, uint8_t y)
+{
+  if ( u8log->is_redraw_all )
+    return 1;
+  if ( y >= U8LOG_DIRTY_LINE_BYTES*8 )
+    return 0;
+  return (u8log->dirty_lines[y>>3] >> (y&7)) & 1;
+}
+
+/* mark line y as dirty, the line is redrawn with the next callback */
+static void u8log_mark_line(u8log_t *u8log, uint8_t y)
+{
+  if ( y >= U8LOG_DIRTY_LINE_BYTES*8 )
+    u8log->is_redraw_all_required_for_next_nl = 1;
+  else
+    u8log->dirty_lines[y>>3] |= 1<<(y&7);
+}
+
+/* mark line y as dirty and request the callback */
+static void u8log_redraw_line(u8log_t *u8log, uint8_t y)
+{
+  u8log_mark_line(u8log, y);
+  u8log->is_redraw_line = 1;
+  u8log->redraw_line = y;
+  if ( y >= U8LOG_DIRTY_LINE_BYTES*8 )
+    u8log->is_redraw_all = 1;
+}
+
+static void u8log_clear_marks(u8log_t *u8log)
+{
+  memset(u8log->dirty_lines, 0, U8LOG_DIRTY_LINE_BYTES);
+  u8log->is_redraw_line = 0;
+  u8log->is_redraw_all = 0;
+}
+
+static void u8log_clear_line(uint8_t *dest, uint8_t cnt)
 {
-  uint8_t *dest = u8log->screen_buffer;
-  uint16_t cnt = u8log->height;
-  cnt *= u8log->width;
   do
   {
     *dest++ = ' ';
     cnt--;
   } while( cnt > 0 );
-  
+}
+
+static void u8log_clear_screen(u8log_t *u8log)
+{
+  uint8_t y;
+  u8log->head = 0;
+  for( y = 0; y < u8log->height; y++ )
+    u8log_clear_line(u8log_GetLine(u8log, y), u8log->width);  
 }
 
 
-/* scroll the content of the complete buffer, set redraw_line to 255 */
+/* scroll the content of the complete buffer by moving the head of the ring buffer */
 static void u8log_scroll_up(u8log_t *u8log)
 {
-  uint8_t *dest = u8log->screen_buffer;
-  uint8_t *src = dest+u8log->width;
-  uint16_t cnt = u8log->height;
-  cnt--;
-  cnt *= u8log->width;
-  do
-  {
-    *dest++ = *src++;
-    cnt--;
-  } while( cnt > 0 );
-  cnt = u8log->width;
-  do
-  {
-    *dest++ = ' ';
-    cnt--;
-  } while(cnt > 0);
+  /* the first line will become the last line */
+  u8log_clear_line(u8log_GetLine(u8log, 0), u8log->width);
+  u8log->head++;
+  if ( u8log->head >= u8log->height )
+    u8log->head = 0;
   
   if ( u8log->is_redraw_line_for_each_char )
     u8log->is_redraw_all = 1;
@@ -98,6 +142,7 @@ static void u8log_cursor_on_screen(u8log_t *u8log)
   //printf("u8log_cursor_on_screen, cursor_y=%d\n", u8log->cursor_y);
   if ( u8log->cursor_x >= u8log->width )
   {
+    u8log_mark_line(u8log, u8log->cursor_y);
     u8log->cursor_x = 0;
     u8log->cursor_y++;
   }
@@ -114,14 +159,13 @@ static void u8log_cursor_on_screen(u8log_t *u8log)
 static void u8log_write_to_screen(u8log_t *u8log, uint8_t c)
 {
   u8log_cursor_on_screen(u8log);
-  u8log->screen_buffer[u8log->cursor_y * u8log->width + u8log->cursor_x] = c;
+  u8log_GetLine(u8log, u8log->cursor_y)[u8log->cursor_x] = c;
   u8log->cursor_x++;
   
   if ( u8log->is_redraw_line_for_each_char )
-  {
-    u8log->is_redraw_line = 1;
-    u8log->redraw_line = u8log->cursor_y;
-  }
+    u8log_redraw_line(u8log, u8log->cursor_y);
+  else
+    u8log_mark_line(u8log, u8log->cursor_y);
 }
 
 /*
@@ -140,18 +184,17 @@ void u8log_write_char(u8log_t *u8log, uint8_t c)
   switch(c)
   {
     case '\n':	// 10
-      u8log->is_redraw_line = 1;
-      u8log->redraw_line = u8log->cursor_y;
-      if ( u8log->is_redraw_all_required_for_next_nl )
-	u8log->is_redraw_all = 1;
-      u8log->is_redraw_all_required_for_next_nl = 0;
+      u8log_redraw_line(u8log, u8log->cursor_y);
       u8log->cursor_y++;
       u8log->cursor_x = 0;
       u8log_cursor_on_screen(u8log);  // 31 Aug 2024 https://github.com/olikraus/u8g2/issues/2319
+      /* check after scrolling, so that a scroll caused by this nl is visible immediately */
+      if ( u8log->is_redraw_all_required_for_next_nl )
+	u8log->is_redraw_all = 1;
+      u8log->is_redraw_all_required_for_next_nl = 0;
       break;	
     case '\r':	// 13
-      u8log->is_redraw_line = 1;
-      u8log->redraw_line = u8log->cursor_y;
+      u8log_redraw_line(u8log, u8log->cursor_y);
       u8log->cursor_x = 0;
       break;
     case '\t':	// 9
@@ -197,20 +240,31 @@ void u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
 
 
 
-void u8log_WriteChar(u8log_t *u8log, uint8_t c)
+/* call the redraw callback, if a line has been marked for redraw */
+void u8log_Redraw(u8log_t *u8log)
 {
-  u8log_write_char(u8log, c);
   if ( u8log->is_redraw_line || u8log->is_redraw_all )
   {
     if ( u8log->cb != 0 )
     {
       u8log->cb(u8log);
     }
-    u8log->is_redraw_line = 0;
-    u8log->is_redraw_all = 0;
+    u8log_clear_marks(u8log);
   }
 }
 
+/* write a char, but do not call the redraw callback, use u8log_Redraw() later */
+void u8log_WriteCharNoRedraw(u8log_t *u8log, uint8_t c)
+{
+  u8log_write_char(u8log, c);
+}
+
+void u8log_WriteChar(u8log_t *u8log, uint8_t c)
+{
+  u8log_write_char(u8log, c);
+  u8log_Redraw(u8log);
+}
+
 void u8log_WriteString(u8log_t *u8log, const char *s)
 {
   while( *s != '\0' )
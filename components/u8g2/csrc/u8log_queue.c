@@ -0,0 +1,169 @@
+/*
+
+  u8log_queue.c
+  
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2018, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+
+  Lock free producer queue for u8log.
+
+  u8log_WriteString() updates the screen buffer and calls the redraw 
+  callback on the caller's thread. Instead, a producer (another task or 
+  an interrupt handler) can write into a u8log_queue_t. The display task
+  calls u8log_DrainQueues(), which forwards the queued text to u8log
+  and calls the redraw callback only once for all pending text.
+  
+  Each queue must have exactly one producer and one consumer. Use one 
+  queue for each producer, all queues of a u8log are drained together.
+  A write is either stored completely or dropped, so text of different
+  producers is only mixed at the boundaries of the write calls.
+
+  Example:
+    uint8_t isr_queue_buf[128];
+    u8log_queue_t isr_queue;
+    
+    u8log_queue_Init(&isr_queue, isr_queue_buf, sizeof(isr_queue_buf));
+    u8log_AddQueue(&u8log, &isr_queue);
+    
+    interrupt handler:
+      u8log_queue_WriteString(&isr_queue, "alarm\n");
+    display task:
+      u8log_DrainQueues(&u8log);
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "u8x8.h"
+
+/* 
+  head and tail are exchanged between producer and consumer. With gcc/clang 
+  use acquire/release ordering, so that the data is visible before the new head.
+  Other compilers fall back to volatile access, which is sufficient on single
+  core controllers.
+*/
+#if defined(__GNUC__)
+#define U8LOG_QUEUE_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define U8LOG_QUEUE_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define U8LOG_QUEUE_LOAD(p) (*(p))
+#define U8LOG_QUEUE_STORE(p, v) (*(p) = (v))
+#endif
+
+/* size must be a power of 2, one byte less than size can be stored in the queue */
+void u8log_queue_Init(u8log_queue_t *queue, uint8_t *buf, uint16_t size)
+{
+  memset(queue, 0, sizeof(u8log_queue_t));
+  queue->buf = buf;
+  queue->mask = size-1;
+}
+
+/*
+  Producer: Append len bytes to the queue. Returns 0 and increments the 
+  drop counter, if there is not enough space for all bytes.
+  Does not block and can be called from an interrupt handler.
+*/
+uint8_t u8log_queue_Write(u8log_queue_t *queue, const uint8_t *data, uint16_t len)
+{
+  uint16_t head = queue->head;
+  uint16_t tail = U8LOG_QUEUE_LOAD(&(queue->tail));
+  uint16_t free_cnt = (uint16_t)(tail - head - 1) & queue->mask;
+  
+  if ( len > free_cnt )
+  {
+    queue->drop_cnt++;
+    return 0;
+  }
+  while( len > 0 )
+  {
+    queue->buf[head & queue->mask] = *data++;
+    head++;
+    len--;
+  }
+  U8LOG_QUEUE_STORE(&(queue->head), head & queue->mask);
+  return 1;
+}
+
+uint8_t u8log_queue_WriteString(u8log_queue_t *queue, const char *s)
+{
+  size_t len = strlen(s);
+  if ( len > queue->mask )
+  {
+    queue->drop_cnt++;
+    return 0;
+  }
+  return u8log_queue_Write(queue, (const uint8_t *)s, len);
+}
+
+uint8_t u8log_queue_WriteChar(u8log_queue_t *queue, uint8_t c)
+{
+  return u8log_queue_Write(queue, &c, 1);
+}
+
+/* returns the number of dropped writes since u8log_queue_Init() */
+uint16_t u8log_queue_GetDropCount(u8log_queue_t *queue)
+{
+  return queue->drop_cnt;
+}
+
+/* attach a queue to u8log, must be called before the producer starts */
+void u8log_AddQueue(u8log_t *u8log, u8log_queue_t *queue)
+{
+  queue->next = u8log->queue_list;
+  u8log->queue_list = queue;
+}
+
+/*
+  Consumer: Forward the content of all queues to u8log and redraw once.
+  Must be called from the task which owns the display.
+  Returns the number of forwarded bytes.
+*/
+uint16_t u8log_DrainQueues(u8log_t *u8log)
+{
+  u8log_queue_t *queue;
+  uint16_t head, tail;
+  uint16_t cnt = 0;
+  
+  for( queue = u8log->queue_list; queue != NULL; queue = queue->next )
+  {
+    head = U8LOG_QUEUE_LOAD(&(queue->head));
+    tail = queue->tail;
+    while( tail != head )
+    {
+      u8log_WriteCharNoRedraw(u8log, queue->buf[tail]);
+      tail = (tail+1) & queue->mask;
+      cnt++;
+    }
+    U8LOG_QUEUE_STORE(&(queue->tail), tail);
+  }
+  u8log_Redraw(u8log);
+  return cnt;
+}
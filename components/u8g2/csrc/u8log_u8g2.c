@@ -48,25 +48,65 @@
   to change the return values for u8g2_GetAscent and u8g2_GetDescent
 
 */
+static u8g2_uint_t u8g2_draw_log_line(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t buf_y, u8log_t *u8log)
+{
+  uint8_t buf_x;
+  uint8_t *line = u8log_GetLine(u8log, buf_y);
+  for( buf_x = 0; buf_x < u8log->width; buf_x++ )
+  {
+    x += u8g2_DrawGlyph(u8g2, x, y, line[buf_x]);
+  }
+  return x;
+}
+
+static u8g2_uint_t u8g2_get_log_line_height(u8g2_t *u8g2, u8log_t *u8log)
+{
+  return u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2) + u8log->line_height_offset;
+}
+
 void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
 {
-  u8g2_uint_t disp_x, disp_y;
-  uint8_t buf_x, buf_y;
-  uint8_t c;
+  u8g2_uint_t disp_y;
+  uint8_t buf_y;
   
   disp_y = y;  
   u8g2_SetFontDirection(u8g2, 0);
   for( buf_y = 0; buf_y < u8log->height; buf_y++ )
   {
-    disp_x = x;
-    for( buf_x = 0; buf_x < u8log->width; buf_x++ )
+    u8g2_draw_log_line(u8g2, x, disp_y, buf_y, u8log);
+    disp_y += u8g2_get_log_line_height(u8g2, u8log);
+  }
+}
+
+/*
+  returns 1 if the current page window intersects with a line of the log.
+  y: baseline of the first line
+  is_dirty_only: only check lines marked with u8log_IsLineDirty()
+  draw: draw all lines which intersect with the page window
+*/
+static uint8_t u8g2_log_page(u8g2_t *u8g2, u8g2_uint_t y, u8log_t *u8log, uint8_t is_dirty_only, uint8_t draw)
+{
+  u8g2_long_t top, bottom;
+  u8g2_long_t baseline = y;
+  u8g2_long_t line_height = u8g2_get_log_line_height(u8g2, u8log);
+  uint8_t buf_y;
+  uint8_t is_intersection = 0;
+  
+  for( buf_y = 0; buf_y < u8log->height; buf_y++ )
+  {
+    /* pixel rows of the glyph bounding boxes, including one extra pixel at both ends */
+    top = baseline - u8g2->font_info.max_char_height - u8g2->font_info.y_offset - 1;
+    bottom = baseline - u8g2->font_info.y_offset + 1;
+    if ( bottom > (u8g2_long_t)u8g2->user_y0 && top < (u8g2_long_t)u8g2->user_y1 )
     {
-      c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
-      disp_x += u8g2_DrawGlyph(u8g2, disp_x, disp_y, c);
+      if ( is_dirty_only == 0 || u8log_IsLineDirty(u8log, buf_y) )
+	is_intersection = 1;
+      if ( draw )
+	u8g2_draw_log_line(u8g2, 0, baseline, buf_y, u8log);
     }
-    disp_y += u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2);
-    disp_y += u8log->line_height_offset;
+    baseline += line_height;
   }
+  return is_intersection;
 }
 
 /*
@@ -81,18 +121,42 @@ void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
     u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
   to change the line height.
   
+  Only the parts of the display which contain dirty lines are redrawn and 
+  sent to the display: In page mode, pages without dirty lines are skipped. 
+  In full buffer mode (U8G2_R0 and U8G2_R2) each tile row is handled like a page.
 */
 void u8log_u8g2_cb(u8log_t * u8log)
 {
   u8g2_t *u8g2 = (u8g2_t *)(u8log->aux_data);
+  uint8_t *buf_ptr = u8g2->tile_buf_ptr;
+  uint8_t buf_height = u8g2->tile_buf_height;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  /* tile rows are only useful, if the log lines are horizontal in the buffer */
+  uint8_t is_full_buffer = buf_height >= tile_height && (u8g2->cb == U8G2_R0 || u8g2->cb == U8G2_R2);
+  uint8_t is_dirty_only = u8log->is_redraw_all == 0;
+  uint8_t row;
+  
   if ( u8log->is_redraw_line || u8log->is_redraw_all )
   {
-    u8g2_FirstPage(u8g2);
-    do
+    u8g2_SetFontDirection(u8g2, 0);
+    if ( is_full_buffer )
+      u8g2->tile_buf_height = 1;
+    for( row = 0; row < tile_height; row += u8g2->tile_buf_height )
     {
-      u8g2_DrawLog( u8g2, 0, u8g2_GetAscent(u8g2), u8log);
+      if ( is_full_buffer )
+	u8g2->tile_buf_ptr = buf_ptr + (uint16_t)row*tile_width*8;
+      u8g2_SetBufferCurrTileRow(u8g2, row);
+      if ( is_dirty_only == 0 || u8g2_log_page(u8g2, u8g2_GetAscent(u8g2), u8log, is_dirty_only, 0) )
+      {
+	u8g2_ClearBuffer(u8g2);
+	u8g2_log_page(u8g2, u8g2_GetAscent(u8g2), u8log, is_dirty_only, 1);
+	u8g2_UpdateDisplay(u8g2);
+      }
     }
-    while( u8g2_NextPage(u8g2) );
+    u8g2->tile_buf_ptr = buf_ptr;
+    u8g2->tile_buf_height = buf_height;
+    u8g2_SetBufferCurrTileRow(u8g2, 0);
+    u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
   }
 }
-
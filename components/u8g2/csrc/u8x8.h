@@ -96,6 +96,12 @@
 /* Define this for an additional user pointer inside the u8x8 data struct */
 //#define U8X8_WITH_USER_PTR
 
+/* Define this to measure time and bytes of the display update stages, see u8x8_timing.c */
+//#define U8X8_WITH_TIMING
+
+/* Define this to record the bus traffic with u8x8_ConnectByteRecorder(), see u8x8_byte.c */
+//#define U8X8_WITH_RECORDER
+
 
 /* Undefine this to remove u8x8_SetFlipMode function */
 /* 26 May 2016: Obsolete */
@@ -106,6 +112,22 @@
 /* 26 May 2016: Obsolete */
 //#define U8X8_DEFAULT_FLIP_MODE 0
 
+/* Define this to use a 512 byte lookup table (instead of 16 bytes) for the 2x upscaled u8x8 fonts */
+//#define U8X8_WITH_UPSCALE_WORD_TABLE
+
+/* 
+  Size of the ST7920 line cache in bytes. Lines, which are already on the display, are not sent again.
+  The cache must have pixel_height*tile_width bytes (1024 for 128x64), otherwise it is not used.
+  Use 0 to remove the cache.
+*/
+#ifndef U8X8_ST7920_LINE_CACHE_SIZE
+#ifdef __AVR__
+#define U8X8_ST7920_LINE_CACHE_SIZE 0
+#else
+#define U8X8_ST7920_LINE_CACHE_SIZE 1024
+#endif
+#endif
+
 /*==========================================*/
 /* Includes */
 
@@ -215,6 +237,36 @@ typedef struct u8x8_tile_struct u8x8_tile_t;
 typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 typedef uint16_t (*u8x8_char_cb)(u8x8_t *u8x8, uint8_t b);
 
+#ifdef U8X8_WITH_TIMING
+/* stages of the display update, see u8x8_timing.c */
+#define U8X8_TIMING_RENDER 0		/* drawing into the buffer: ClearBuffer/FirstPage/NextPage until SendBuffer/NextPage */
+#define U8X8_TIMING_FONT 1		/* string drawing, part of U8X8_TIMING_RENDER */
+#define U8X8_TIMING_SEND 2		/* u8g2_SendBuffer() and the transfer part of u8g2_NextPage() */
+#define U8X8_TIMING_DRAW_TILE 3	/* u8x8_DrawTile(), part of U8X8_TIMING_SEND */
+#define U8X8_TIMING_BYTE 4		/* byte callback, part of U8X8_TIMING_DRAW_TILE */
+#define U8X8_TIMING_STAGE_CNT 5
+
+typedef struct u8x8_timing_stage_struct u8x8_timing_stage_t;
+typedef struct u8x8_timing_struct u8x8_timing_t;
+
+struct u8x8_timing_stage_struct
+{
+  uint32_t cnt;
+  uint32_t min;
+  uint32_t max;
+  uint32_t bytes;
+  uint64_t sum;
+};
+
+struct u8x8_timing_struct
+{
+  u8x8_msg_cb byte_cb;		/* the original byte callback */
+  uint32_t render_start;
+  uint8_t is_render;
+  u8x8_timing_stage_t stage[U8X8_TIMING_STAGE_CNT];
+};
+#endif
+
 
 
 
@@ -366,6 +418,12 @@ struct u8x8_struct
 #ifdef U8X8_WITH_USER_PTR
   void *user_ptr;
 #endif
+#ifdef U8X8_WITH_RECORDER
+  struct u8x8_byte_recorder_struct *recorder;	/* NULL or bus recorder, assigned by u8x8_ConnectByteRecorder() */
+#endif
+#ifdef U8X8_WITH_TIMING
+  u8x8_timing_t *timing;	/* NULL or statistics, assigned by u8x8_timing_Init() */
+#endif
 #ifdef U8X8_USE_PINS 
   uint8_t pins[U8X8_PIN_CNT];	/* defines a pinlist: Mainly a list of pins for the Arduino Environment, use U8X8_PIN_xxx to access */
 #endif
@@ -405,18 +463,24 @@ struct u8x8_struct
 /* u8log extension for u8x8 and u8g2 */
 
 typedef struct u8log_struct u8log_t;
+typedef struct u8log_queue_struct u8log_queue_t;
 
 
 /* redraw the specified line. */
 typedef void (*u8log_cb)(u8log_t * u8log);
 
+/* number of bytes for the dirty line flags, lines beyond 8*U8LOG_DIRTY_LINE_BYTES will redraw the complete screen */
+#ifndef U8LOG_DIRTY_LINE_BYTES
+#define U8LOG_DIRTY_LINE_BYTES 4
+#endif
+
 struct u8log_struct
 {
   /* configuration */
   void *aux_data;		/* pointer to u8x8 or u8g2 */
   uint8_t width, height;	/* size of the terminal */
   u8log_cb cb;			/* callback redraw function */
-  uint8_t *screen_buffer;	/* size must be width*height bytes */
+  uint8_t *screen_buffer;	/* size must be width*height bytes, ring buffer, use u8log_GetLine() to access a line */
   uint8_t is_redraw_line_for_each_char;
   int8_t line_height_offset;		/* extra offset for the line height (u8g2 only) */
   
@@ -424,9 +488,29 @@ struct u8log_struct
   //uint8_t last_x, last_y;	/* position of the last printed char */
   uint8_t cursor_x, cursor_y;  /* position of the cursor, might be off screen */
   uint8_t redraw_line;	/* redraw specific line if is_redraw_line is not 0 */
-  uint8_t is_redraw_line;
+  uint8_t is_redraw_line;	/* at least one line is marked in dirty_lines */
   uint8_t is_redraw_all;
   uint8_t is_redraw_all_required_for_next_nl; /* in nl mode, redraw all instead of current line */
+  uint8_t head;			/* line of the screen_buffer which is shown in the first line of the display */
+  uint8_t dirty_lines[U8LOG_DIRTY_LINE_BYTES];	/* one bit per display line, see u8log_IsLineDirty() */
+  u8log_queue_t *queue_list;	/* producer queues, see u8log_AddQueue() */
+};
+
+/*
+  Lock free single producer, single consumer byte queue for u8log.
+  The producer (a task or an interrupt) writes with u8log_queue_WriteString(),
+  the consumer (the display task) forwards all queues of a u8log with 
+  u8log_DrainQueues() and redraws the display only once.
+  Use one queue for each producer, if there are several producers.
+*/
+struct u8log_queue_struct
+{
+  u8log_queue_t *next;		/* next queue of the same u8log */
+  uint8_t *buf;			/* size bytes, provided by the user */
+  uint16_t mask;			/* size-1, size must be a power of 2 */
+  volatile uint16_t head;		/* write position, only changed by the producer */
+  volatile uint16_t tail;		/* read position, only changed by the consumer */
+  volatile uint16_t drop_cnt;	/* number of dropped writes, only changed by the producer */
 };
 
 
@@ -435,6 +519,7 @@ struct u8log_struct
 /* helper functions */
 void u8x8_d_helper_display_setup_memory(u8x8_t *u8x8, const u8x8_display_info_t *display_info);
 void u8x8_d_helper_display_init(u8x8_t *u8g2);
+void u8x8_d_helper_send_inverted_tiles(u8x8_t *u8x8, uint8_t arg_int, u8x8_tile_t *tile);
 
 /* Display Interface */
 
@@ -533,6 +618,23 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_REFRESH_PARTIAL
+  Args:	
+    arg_int: -
+    arg_ptr: -
+  
+  Same as U8X8_MSG_DISPLAY_REFRESH, but the e-paper controller uses a 
+  partial update waveform: Only pixels, which have changed, are driven.
+  This is much faster, but leaves some ghosting on the display. 
+  From time to time a full refresh is required (see u8g2_epd.c).
+  Use
+    uint8_t u8x8_RefreshDisplayPartial(u8x8_t *u8x8)
+  to send the message to the display handler. The display handler 
+  returns 0 if a partial refresh is not supported.
+*/
+#define U8X8_MSG_DISPLAY_REFRESH_PARTIAL 17
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -583,6 +685,7 @@ void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)  U8X8_NOINLINE;
 void u8x8_ClearDisplay(u8x8_t *u8x8);	// this does not work for u8g2 in some cases
 void u8x8_FillDisplay(u8x8_t *u8x8);
 void u8x8_RefreshDisplay(u8x8_t *u8x8);	// make RAM content visible on the display (Dec 16: SSD1606 only)
+uint8_t u8x8_RefreshDisplayPartial(u8x8_t *u8x8);	// same with partial update waveform, returns 0 if not supported
 void u8x8_ClearLine(u8x8_t *u8x8, uint8_t line);
 
 
@@ -704,6 +807,30 @@ uint8_t u8x8_byte_ks0108(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
 uint8_t u8x8_byte_ssd13xx_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);  /* OBSOLETE! */
 uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_byte_4wire_sw_spi_fast(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_byte_sw_i2c_fast(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+#ifdef U8X8_WITH_RECORDER
+/* bus transaction recorder, see u8x8_trace.c for the analysis of the recorded trace */
+typedef struct u8x8_byte_recorder_struct u8x8_byte_recorder_t;
+typedef uint32_t (*u8x8_recorder_time_cb)(void);	/* returns a free running timestamp in microseconds */
+
+struct u8x8_byte_recorder_struct
+{
+  u8x8_msg_cb next_cb;		/* the original byte procedure, can be u8x8_byte_empty */
+  u8x8_recorder_time_cb time_cb;	/* can be NULL, then all timestamps are 0 */
+  uint8_t *buf;
+  uint32_t size;			/* size of buf */
+  uint32_t len;			/* number of used bytes in buf */
+  uint32_t last_time;
+  uint32_t dropped;		/* number of records, which did not fit into buf */
+};
+
+uint8_t u8x8_byte_recorder(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+void u8x8_ConnectByteRecorder(u8x8_t *u8x8, u8x8_byte_recorder_t *recorder, uint8_t *buf, uint32_t size, u8x8_recorder_time_cb time_cb);
+void u8x8_DisconnectByteRecorder(u8x8_t *u8x8);
+void u8x8_ByteRecorderMarkFrame(u8x8_t *u8x8);
+#endif
 
 
 /*==========================================*/
@@ -729,6 +856,32 @@ uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_
 /* delay of one i2c unit, should be 5us for 100K, and 1.25us for 400K */
 #define U8X8_MSG_DELAY_I2C		45
 
+/* 
+  U8X8_MSG_GPIO_FAST_IO
+  Optional, used by u8x8_byte_4wire_sw_spi_fast and u8x8_byte_sw_i2c_fast
+  arg_int: U8X8_FAST_IO_SPI or U8X8_FAST_IO_I2C
+  arg_ptr: pointer to u8x8_fast_io_t, which should be filled by the callback
+  return 1 if the registers have been provided, return 0 to use the generic (slow) procedure 
+*/
+#define U8X8_MSG_GPIO_FAST_IO		46
+#define U8X8_FAST_IO_SPI 0
+#define U8X8_FAST_IO_I2C 1
+
+/* 
+  Set and clear registers for the clock and data line. A write of "mask" to
+  "set_reg" drives the line high (or releases it for i2c), a write to
+  "clr_reg" drives it low. Both lines must be controlled by the same registers.
+*/
+typedef struct u8x8_fast_io_struct u8x8_fast_io_t;
+struct u8x8_fast_io_struct
+{
+  volatile uint32_t *set_reg;
+  volatile uint32_t *clr_reg;
+  uint32_t clock_mask;
+  uint32_t data_mask;
+  uint16_t delay_cnt;	/* number of busy loops for each half clock period, 0 for max speed */
+};
+
 #define U8X8_MSG_GPIO(x) (64+(x))
 #ifdef U8X8_USE_PINS 
 #define u8x8_GetPinIndex(u8x8, msg) ((msg)&0x3f)
@@ -789,6 +942,39 @@ void u8x8_gpio_call(u8x8_t *u8x8, uint8_t msg, uint8_t arg) U8X8_NOINLINE;
 //void u8x8_gpio_Delay(u8x8_t *u8x8, uint8_t msg, uint8_t dly) U8X8_NOINLINE;
 
 
+/*==========================================*/
+/* u8x8_timing.c */
+
+#ifdef U8X8_WITH_TIMING
+
+/* 
+  Ticks are CPU cycles on the ESP32 (esp_cpu_get_cycle_count) and nanoseconds 
+  on POSIX systems (clock_gettime). Redefine U8X8_TIMING_GET_TICKS() for other systems.
+*/
+uint32_t u8x8_timing_GetTicks(void);
+void u8x8_timing_Init(u8x8_t *u8x8, u8x8_timing_t *timing);	/* call after setup, installs a wrapper for the byte callback */
+void u8x8_timing_Reset(u8x8_timing_t *timing);
+uint32_t u8x8_timing_Begin(u8x8_t *u8x8);
+void u8x8_timing_End(u8x8_t *u8x8, uint8_t stage, uint32_t start, uint32_t bytes);
+void u8x8_timing_StartRender(u8x8_t *u8x8);
+void u8x8_timing_EndRender(u8x8_t *u8x8);
+/* writes one line "<stage> cnt min avg max bytes" for each stage */
+void u8x8_timing_Print(u8x8_timing_t *timing, void (*out)(const char *s));
+
+#define U8X8_TIMING_BEGIN(u8x8) uint32_t u8x8_timing_start = u8x8_timing_Begin(u8x8)
+#define U8X8_TIMING_END(u8x8, stage, bytes) u8x8_timing_End((u8x8), (stage), u8x8_timing_start, (bytes))
+#define U8X8_TIMING_START_RENDER(u8x8) u8x8_timing_StartRender(u8x8)
+#define U8X8_TIMING_END_RENDER(u8x8) u8x8_timing_EndRender(u8x8)
+
+#else
+
+#define U8X8_TIMING_BEGIN(u8x8)
+#define U8X8_TIMING_END(u8x8, stage, bytes)
+#define U8X8_TIMING_START_RENDER(u8x8)
+#define U8X8_TIMING_END_RENDER(u8x8)
+
+#endif
+
 /*==========================================*/
 /* u8x8_debounce.c */
 /* return U8X8_MSG_GPIO_MENU_xxxxx messages */
@@ -1071,6 +1257,14 @@ uint8_t u8x8_d_ssd1315_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 /*==========================================*/
 /* u8x8_8x8.c */
 
+/* 
+  Number of tiles, which are collected by the string procedures before they are sent to the display.
+  The string procedures require 8*U8X8_STRING_TILE_BUF_CNT bytes on the stack.
+*/
+#ifndef U8X8_STRING_TILE_BUF_CNT
+#define U8X8_STRING_TILE_BUF_CNT 8
+#endif
+
 uint16_t u8x8_upscale_byte(uint8_t x) U8X8_NOINLINE;
 
 void u8x8_get_glyph_data(u8x8_t *u8x8, uint8_t encoding, uint8_t *buf, uint8_t tile_offset) U8X8_NOINLINE;
@@ -1092,6 +1286,9 @@ uint8_t u8x8_Draw2x2String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
 uint8_t u8x8_Draw2x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
 uint8_t u8x8_Draw1x2String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
 uint8_t u8x8_Draw1x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
+void u8x8_DrawScaledGlyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, uint8_t encoding);
+uint8_t u8x8_DrawScaledString(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, const char *s);
+uint8_t u8x8_DrawScaledUTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, const char *s);
 uint8_t u8x8_GetUTF8Len(u8x8_t *u8x8, const char *s);
 #define u8x8_SetInverseFont(u8x8, b) (u8x8)->is_font_inverse_mode = (b)
 
@@ -1162,6 +1359,53 @@ void u8x8_capture_write_xbm_buffer(uint8_t *buffer, uint8_t tile_width, uint8_t
 
 
 
+/*==========================================*/
+/* u8x8_trace.c */
+
+/* 
+  Trace format written by u8x8_byte_recorder:
+    header: 'u' '8' 't' 'r' version i2c_address tile_width tile_height
+    records: type | (delta_us << 3) in one byte, if delta_us >= 31 then
+      the upper 5 bits are 31 and delta_us follows as 7 bit varint (lsb first)
+    U8X8_TRACE_SET_DC: followed by the dc value
+    U8X8_TRACE_SEND: followed by the number of bytes and the bytes
+*/
+#define U8X8_TRACE_VERSION 1
+#define U8X8_TRACE_HEADER_SIZE 8
+
+#define U8X8_TRACE_INIT 0
+#define U8X8_TRACE_SET_DC 1
+#define U8X8_TRACE_SEND 2
+#define U8X8_TRACE_START_TRANSFER 3
+#define U8X8_TRACE_END_TRANSFER 4
+#define U8X8_TRACE_FRAME 5
+
+/* bus types for u8x8_trace_EstimateWireTime */
+#define U8X8_TRACE_BUS_I2C 0
+#define U8X8_TRACE_BUS_SPI 1
+
+typedef struct u8x8_trace_stats_struct u8x8_trace_stats_t;
+
+struct u8x8_trace_stats_struct
+{
+  uint32_t records;
+  uint32_t frames;		/* number of u8x8_ByteRecorderMarkFrame() calls */
+  uint32_t transfers;		/* START_TRANSFER/END_TRANSFER pairs */
+  uint32_t sends;		/* number of U8X8_MSG_BYTE_SEND messages */
+  uint32_t bytes;		/* total number of bytes sent */
+  uint32_t cmd_bytes;		/* command and argument bytes */
+  uint32_t data_bytes;		/* display ram bytes */
+  uint32_t ctrl_bytes;		/* i2c control bytes (0x00/0x40 for SSD13xx) */
+  uint32_t dc_changes;		/* number of SET_DC messages */
+  uint32_t duration_us;		/* time between first and last record */
+};
+
+uint8_t u8x8_trace_Analyse(const uint8_t *trace, uint32_t len, u8x8_trace_stats_t *stats);
+uint32_t u8x8_trace_EstimateWireTime(const u8x8_trace_stats_t *stats, uint8_t bus, uint32_t bus_hz);
+/* gram: 1024 bytes, page organized like the SSD1306 (read with u8x8_capture_get_pixel_1, tile_width = 16) */
+uint8_t u8x8_trace_ReplaySSD1306(const uint8_t *trace, uint32_t len, uint8_t *gram);
+
+
 /*==========================================*/
 
 /* u8x8_input_value.c  */
@@ -1181,6 +1425,20 @@ void u8log_WriteHex16(u8log_t *u8log, uint16_t v);
 void u8log_WriteHex32(u8log_t *u8log, uint32_t v);
 void u8log_WriteDec8(u8log_t *u8log, uint8_t v, uint8_t d);
 void u8log_WriteDec16(u8log_t *u8log, uint16_t v, uint8_t d);
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y);
+uint8_t u8log_IsLineDirty(u8log_t *u8log, uint8_t y);
+void u8log_WriteCharNoRedraw(u8log_t *u8log, uint8_t c);
+void u8log_Redraw(u8log_t *u8log);
+
+/*==========================================*/
+/* u8log_queue.c */
+void u8log_queue_Init(u8log_queue_t *queue, uint8_t *buf, uint16_t size);
+uint8_t u8log_queue_Write(u8log_queue_t *queue, const uint8_t *data, uint16_t len);
+uint8_t u8log_queue_WriteString(u8log_queue_t *queue, const char *s);
+uint8_t u8log_queue_WriteChar(u8log_queue_t *queue, uint8_t c);
+uint16_t u8log_queue_GetDropCount(u8log_queue_t *queue);
+void u8log_AddQueue(u8log_t *u8log, u8log_queue_t *queue);
+uint16_t u8log_DrainQueues(u8log_t *u8log);
 
 /*==========================================*/
 /* u8log_u8x8.c */
@@ -36,6 +36,7 @@
 */
 
 #include "u8x8.h"
+#include <string.h>
 
 #if defined(ESP8266)
 uint8_t u8x8_pgm_read_esp(const uint8_t * addr) 
@@ -127,42 +128,69 @@ void u8x8_DrawGlyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding)
 
 
 /*
-  Source: http://graphics.stanford.edu/~seander/bithacks.html
-	Section: Interleave bits by Binary Magic Numbers 
-   Original codes is here:
-		static const unsigned int B[] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF};
-		static const unsigned int S[] = {1, 2, 4, 8};
-
-		unsigned int x; // Interleave lower 16 bits of x and y, so the bits of x
-		unsigned int y; // are in the even positions and bits from y in the odd;
-		unsigned int z; // z gets the resulting 32-bit Morton Number.  
-				// x and y must initially be less than 65536.
-
-		x = (x | (x << S[3])) & B[3];
-		x = (x | (x << S[2])) & B[2];
-		x = (x | (x << S[1])) & B[1];
-		x = (x | (x << S[0])) & B[0];
-
-		y = (y | (y << S[3])) & B[3];
-		y = (y | (y << S[2])) & B[2];
-		y = (y | (y << S[1])) & B[1];
-		y = (y | (y << S[0])) & B[0];
-
-		z = x | (y << 1);
+  Double each bit of x: Bit n of x is copied to bit 2n and 2n+1 of the result.
+  
+  By default a 16 byte table (placed in flash/PROGMEM) is used for each nibble.
+  With U8X8_WITH_UPSCALE_WORD_TABLE a 512 byte table is used instead, which
+  returns the result with a single lookup. Note: On AVR the 512 byte table
+  is placed in RAM.
 */
+#ifdef U8X8_WITH_UPSCALE_WORD_TABLE
+static const uint16_t u8x8_upscale_word_table[256] =
+{
+  0x0000, 0x0003, 0x000c, 0x000f, 0x0030, 0x0033, 0x003c, 0x003f,
+  0x00c0, 0x00c3, 0x00cc, 0x00cf, 0x00f0, 0x00f3, 0x00fc, 0x00ff,
+  0x0300, 0x0303, 0x030c, 0x030f, 0x0330, 0x0333, 0x033c, 0x033f,
+  0x03c0, 0x03c3, 0x03cc, 0x03cf, 0x03f0, 0x03f3, 0x03fc, 0x03ff,
+  0x0c00, 0x0c03, 0x0c0c, 0x0c0f, 0x0c30, 0x0c33, 0x0c3c, 0x0c3f,
+  0x0cc0, 0x0cc3, 0x0ccc, 0x0ccf, 0x0cf0, 0x0cf3, 0x0cfc, 0x0cff,
+  0x0f00, 0x0f03, 0x0f0c, 0x0f0f, 0x0f30, 0x0f33, 0x0f3c, 0x0f3f,
+  0x0fc0, 0x0fc3, 0x0fcc, 0x0fcf, 0x0ff0, 0x0ff3, 0x0ffc, 0x0fff,
+  0x3000, 0x3003, 0x300c, 0x300f, 0x3030, 0x3033, 0x303c, 0x303f,
+  0x30c0, 0x30c3, 0x30cc, 0x30cf, 0x30f0, 0x30f3, 0x30fc, 0x30ff,
+  0x3300, 0x3303, 0x330c, 0x330f, 0x3330, 0x3333, 0x333c, 0x333f,
+  0x33c0, 0x33c3, 0x33cc, 0x33cf, 0x33f0, 0x33f3, 0x33fc, 0x33ff,
+  0x3c00, 0x3c03, 0x3c0c, 0x3c0f, 0x3c30, 0x3c33, 0x3c3c, 0x3c3f,
+  0x3cc0, 0x3cc3, 0x3ccc, 0x3ccf, 0x3cf0, 0x3cf3, 0x3cfc, 0x3cff,
+  0x3f00, 0x3f03, 0x3f0c, 0x3f0f, 0x3f30, 0x3f33, 0x3f3c, 0x3f3f,
+  0x3fc0, 0x3fc3, 0x3fcc, 0x3fcf, 0x3ff0, 0x3ff3, 0x3ffc, 0x3fff,
+  0xc000, 0xc003, 0xc00c, 0xc00f, 0xc030, 0xc033, 0xc03c, 0xc03f,
+  0xc0c0, 0xc0c3, 0xc0cc, 0xc0cf, 0xc0f0, 0xc0f3, 0xc0fc, 0xc0ff,
+  0xc300, 0xc303, 0xc30c, 0xc30f, 0xc330, 0xc333, 0xc33c, 0xc33f,
+  0xc3c0, 0xc3c3, 0xc3cc, 0xc3cf, 0xc3f0, 0xc3f3, 0xc3fc, 0xc3ff,
+  0xcc00, 0xcc03, 0xcc0c, 0xcc0f, 0xcc30, 0xcc33, 0xcc3c, 0xcc3f,
+  0xccc0, 0xccc3, 0xcccc, 0xcccf, 0xccf0, 0xccf3, 0xccfc, 0xccff,
+  0xcf00, 0xcf03, 0xcf0c, 0xcf0f, 0xcf30, 0xcf33, 0xcf3c, 0xcf3f,
+  0xcfc0, 0xcfc3, 0xcfcc, 0xcfcf, 0xcff0, 0xcff3, 0xcffc, 0xcfff,
+  0xf000, 0xf003, 0xf00c, 0xf00f, 0xf030, 0xf033, 0xf03c, 0xf03f,
+  0xf0c0, 0xf0c3, 0xf0cc, 0xf0cf, 0xf0f0, 0xf0f3, 0xf0fc, 0xf0ff,
+  0xf300, 0xf303, 0xf30c, 0xf30f, 0xf330, 0xf333, 0xf33c, 0xf33f,
+  0xf3c0, 0xf3c3, 0xf3cc, 0xf3cf, 0xf3f0, 0xf3f3, 0xf3fc, 0xf3ff,
+  0xfc00, 0xfc03, 0xfc0c, 0xfc0f, 0xfc30, 0xfc33, 0xfc3c, 0xfc3f,
+  0xfcc0, 0xfcc3, 0xfccc, 0xfccf, 0xfcf0, 0xfcf3, 0xfcfc, 0xfcff,
+  0xff00, 0xff03, 0xff0c, 0xff0f, 0xff30, 0xff33, 0xff3c, 0xff3f,
+  0xffc0, 0xffc3, 0xffcc, 0xffcf, 0xfff0, 0xfff3, 0xfffc, 0xffff
+};
+
 uint16_t u8x8_upscale_byte(uint8_t x) 
 {
-	uint16_t y = x;
-	y |= (y << 4);		// x = (x | (x << S[2])) & B[2];
-	y &= 0x0f0f;
-	y |= (y << 2);		// x = (x | (x << S[1])) & B[1];
-	y &= 0x3333;
-	y |= (y << 1);		// x = (x | (x << S[0])) & B[0];
-	y &= 0x5555;
-  
-	y |= (y << 1);		// z = x | (y << 1);
-	return y;
+  return u8x8_upscale_word_table[x];
 }
+#else
+static const uint8_t u8x8_upscale_nibble_table[16] U8X8_PROGMEM =
+{
+  0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f, 0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff
+};
+
+uint16_t u8x8_upscale_byte(uint8_t x) 
+{
+  uint16_t y;
+  y = u8x8_pgm_read(u8x8_upscale_nibble_table + (x >> 4));
+  y <<= 8;
+  y |= u8x8_pgm_read(u8x8_upscale_nibble_table + (x & 15));
+  return y;
+}
+#endif
 
 static void u8x8_upscale_buf(uint8_t *src, uint8_t *dest) U8X8_NOINLINE;
 static void u8x8_upscale_buf(uint8_t *src, uint8_t *dest)
@@ -355,120 +383,226 @@ uint16_t u8x8_utf8_next(u8x8_t *u8x8, uint8_t b)
 
 
 
-static uint8_t u8x8_draw_string(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s) U8X8_NOINLINE;
-static uint8_t u8x8_draw_string(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+/*
+  Calculate one tile of a glyph tile, which is upscaled by sx (horizontal) and sy (vertical).
+  The upscaled glyph tile covers sx*sy tiles, ox (0..sx-1) and oy (0..sy-1) select the tile.
+  src: 8 bytes of the glyph tile, dest: 8 bytes of the upscaled tile
+*/
+static void u8x8_get_scaled_tile(const uint8_t *src, uint8_t *dest, uint8_t ox, uint8_t oy, uint8_t sx, uint8_t sy) U8X8_NOINLINE;
+static void u8x8_get_scaled_tile(const uint8_t *src, uint8_t *dest, uint8_t ox, uint8_t oy, uint8_t sx, uint8_t sy)
+{
+  uint8_t i, j, b, d, src_bit, src_cnt;
+  uint8_t src_col = (uint8_t)(ox*8) / sx;
+  uint8_t src_col_cnt = (uint8_t)(ox*8) % sx;
+  uint8_t first_bit = (uint8_t)(oy*8) / sy;
+  uint8_t first_cnt = (uint8_t)(oy*8) % sy;
+  
+  for( i = 0; i < 8; i++ )
+  {
+    b = src[src_col];
+    if ( sy == 1 )
+    {
+      d = b;
+    }
+    else if ( sy == 2 )
+    {
+      if ( oy == 0 )
+	d = u8x8_upscale_byte(b) & 255;
+      else
+	d = u8x8_upscale_byte(b) >> 8;
+    }
+    else
+    {
+      d = 0;
+      src_bit = first_bit;
+      src_cnt = first_cnt;
+      for( j = 0; j < 8; j++ )
+      {
+	if ( (b >> src_bit) & 1 )
+	  d |= 1 << j;
+	src_cnt++;
+	if ( src_cnt >= sy )
+	{
+	  src_cnt = 0;
+	  src_bit++;
+	}
+      }
+    }
+    dest[i] = d;
+    src_col_cnt++;
+    if ( src_col_cnt >= sx )
+    {
+      src_col_cnt = 0;
+      src_col++;
+    }
+  }
+}
+
+/*
+  String output: All tiles of one tile row of the string are collected in a
+  row buffer and sent with a single u8x8_DrawTile() call. The string is decoded 
+  once for each tile row of the (upscaled) font.
+  The row buffer has U8X8_STRING_TILE_BUF_CNT tiles, longer strings are sent in
+  several chunks. Tiles beyond the right border of the display are not sent.
+  
+  sx, sy: upscale factor in x and y direction (1..8)
+*/
+static uint8_t u8x8_draw_string_tiles(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s, uint8_t sx, uint8_t sy) U8X8_NOINLINE;
+static uint8_t u8x8_draw_string_tiles(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s, uint8_t sx, uint8_t sy)
 {
   uint16_t e;
-  uint8_t cnt = 0;
+  uint8_t cnt;
   uint8_t th = u8x8_pgm_read(u8x8->font+2);		/* new 2019 format */
-
-  u8x8_utf8_init(u8x8);
-  for(;;)
+  uint8_t tv = u8x8_pgm_read(u8x8->font+3);	/* new 2019 format */
+  uint8_t tile_width = u8x8->display_info->tile_width;
+  uint8_t row, oy, col, ox, xx, n;
+  const char *str;
+  uint8_t src[8];
+  uint8_t buf[U8X8_STRING_TILE_BUF_CNT*8];
+
+  row = 0;
+  oy = 0;
+  do
   {
-    e = u8x8->next_cb(u8x8, (uint8_t)*s);
-    if ( e == 0x0ffff )
-      break;
-    s++;
-    if ( e != 0x0fffe )
+    str = s;
+    xx = x;		/* position of the first tile in buf */
+    n = 0;		/* number of tiles in buf */
+    cnt = 0;
+    u8x8_utf8_init(u8x8);
+    for(;;)
     {
-      u8x8_DrawGlyph(u8x8, x, y, e);
-      x+=th;
+      e = u8x8->next_cb(u8x8, (uint8_t)*str);
+      if ( e == 0x0ffff )
+	break;
+      str++;
+      if ( e == 0x0fffe )
+	continue;
       cnt++;
+      for( col = 0; col < th; col++ )
+      {
+	u8x8_get_glyph_data(u8x8, e, src, row*th+col);
+	for( ox = 0; ox < sx; ox++ )
+	{
+	  if ( xx + n >= tile_width )
+	    break;
+	  if ( n >= U8X8_STRING_TILE_BUF_CNT )
+	  {
+	    u8x8_DrawTile(u8x8, xx, y, n, buf);
+	    xx += n;
+	    n = 0;
+	  }
+	  if ( sx == 1 && sy == 1 )
+	    memcpy(buf+n*8, src, 8);
+	  else
+	    u8x8_get_scaled_tile(src, buf+n*8, ox, oy, sx, sy);
+	  n++;
+	}
+      }
     }
-  }
+    if ( n > 0 )
+      u8x8_DrawTile(u8x8, xx, y, n, buf);
+    y++;
+    oy++;
+    if ( oy >= sy )
+    {
+      oy = 0;
+      row++;
+    }
+  } while( row < tv );
   return cnt;
 }
 
-
 uint8_t u8x8_DrawString(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
 {
   u8x8->next_cb = u8x8_ascii_next;
-  return u8x8_draw_string(u8x8, x, y, s);
+  return u8x8_draw_string_tiles(u8x8, x, y, s, 1, 1);
 }
 
 uint8_t u8x8_DrawUTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
 {
   u8x8->next_cb = u8x8_utf8_next;
-  return u8x8_draw_string(u8x8, x, y, s);
-}
-
-
-
-static uint8_t u8x8_draw_2x2_string(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s) U8X8_NOINLINE;
-static uint8_t u8x8_draw_2x2_string(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
-{
-  uint16_t e;
-  uint8_t cnt = 0;
-  uint8_t th = u8x8_pgm_read(u8x8->font+2);	/* new 2019 format */
-  
-  th <<= 1;
-  
-  u8x8_utf8_init(u8x8);
-  for(;;)
-  {
-    e = u8x8->next_cb(u8x8, (uint8_t)*s);
-    if ( e == 0x0ffff )
-      break;
-    s++;
-    if ( e != 0x0fffe )
-    {
-      u8x8_Draw2x2Glyph(u8x8, x, y, e);
-      x+=th;
-      cnt++;
-    }
-  }
-  return cnt;
+  return u8x8_draw_string_tiles(u8x8, x, y, s, 1, 1);
 }
 
-
 uint8_t u8x8_Draw2x2String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
 {
   u8x8->next_cb = u8x8_ascii_next;
-  return u8x8_draw_2x2_string(u8x8, x, y, s);
+  return u8x8_draw_string_tiles(u8x8, x, y, s, 2, 2);
 }
 
 uint8_t u8x8_Draw2x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
 {
   u8x8->next_cb = u8x8_utf8_next;
-  return u8x8_draw_2x2_string(u8x8, x, y, s);
+  return u8x8_draw_string_tiles(u8x8, x, y, s, 2, 2);
 }
 
+uint8_t u8x8_Draw1x2String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+{
+  u8x8->next_cb = u8x8_ascii_next;
+  return u8x8_draw_string_tiles(u8x8, x, y, s, 1, 2);
+}
 
-
-static uint8_t u8x8_draw_1x2_string(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s) U8X8_NOINLINE;
-static uint8_t u8x8_draw_1x2_string(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
-{  
-  uint16_t e;
-  uint8_t cnt = 0;
-  uint8_t th = u8x8_pgm_read(u8x8->font+2);	/* new 2019 format */
-  u8x8_utf8_init(u8x8);
-  for(;;)
-  {
-    e = u8x8->next_cb(u8x8, (uint8_t)*s);
-    if ( e == 0x0ffff )
-      break;
-    s++;
-    if ( e != 0x0fffe )
-    {
-      u8x8_Draw1x2Glyph(u8x8, x, y, e);
-      x+=th;
-      cnt++;
-    }
-  }
-  return cnt;
+uint8_t u8x8_Draw1x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+{
+  u8x8->next_cb = u8x8_utf8_next;
+  return u8x8_draw_string_tiles(u8x8, x, y, s, 1, 2);
 }
 
+/* limit the upscale factor to 1..8 */
+static uint8_t u8x8_limit_scale(uint8_t s)
+{
+  if ( s == 0 )
+    return 1;
+  if ( s > 8 )
+    return 8;
+  return s;
+}
 
-uint8_t u8x8_Draw1x2String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+/* 
+  Draw a string, upscaled by sx (horizontal) and sy (vertical). sx and sy are limited to 1..8.
+  Each glyph requires sx*sy times the tiles of the font.
+*/
+uint8_t u8x8_DrawScaledString(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, const char *s)
 {
   u8x8->next_cb = u8x8_ascii_next;
-  return u8x8_draw_1x2_string(u8x8, x, y, s);
+  return u8x8_draw_string_tiles(u8x8, x, y, s, u8x8_limit_scale(sx), u8x8_limit_scale(sy));
 }
 
-uint8_t u8x8_Draw1x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+uint8_t u8x8_DrawScaledUTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, const char *s)
 {
   u8x8->next_cb = u8x8_utf8_next;
-  return u8x8_draw_1x2_string(u8x8, x, y, s);
+  return u8x8_draw_string_tiles(u8x8, x, y, s, u8x8_limit_scale(sx), u8x8_limit_scale(sy));
+}
+
+void u8x8_DrawScaledGlyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t sx, uint8_t sy, uint8_t encoding)
+{
+  uint8_t th = u8x8_pgm_read(u8x8->font+2);		/* new 2019 format */
+  uint8_t tv = u8x8_pgm_read(u8x8->font+3);	/* new 2019 format */
+  uint8_t tile_width = u8x8->display_info->tile_width;
+  uint8_t row, col, ox, oy;
+  uint16_t xx;
+  uint8_t src[8];
+  uint8_t buf[8];
+  sx = u8x8_limit_scale(sx);
+  sy = u8x8_limit_scale(sy);
+  for( row = 0; row < tv; row++ )
+  {
+    for( col = 0; col < th; col++ )
+    {
+      u8x8_get_glyph_data(u8x8, encoding, src, row*th+col);
+      for( oy = 0; oy < sy; oy++ )
+      {
+	for( ox = 0; ox < sx; ox++ )
+	{
+	  xx = x+col*sx+ox;
+	  if ( xx >= tile_width )
+	    break;		/* tiles beyond the right border of the display are not sent */
+	  u8x8_get_scaled_tile(src, buf, ox, oy, sx, sy);
+	  u8x8_DrawTile(u8x8, xx, y+row*sy+oy, 1, buf);
+	}
+      }
+    }
+  }
 }
 
 
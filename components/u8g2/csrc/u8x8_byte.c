@@ -78,6 +78,154 @@ uint8_t u8x8_byte_empty(U8X8_UNUSED u8x8_t *u8x8, uint8_t msg, U8X8_UNUSED uint8
 }
 
 
+/*=========================================*/
+
+/*
+  Bus transaction recorder
+  
+  All byte messages are appended to a trace buffer and then forwarded to the 
+  original byte procedure. Use u8x8_byte_empty as original byte procedure to 
+  profile a display without hardware. The trace is evaluated with the 
+  procedures from u8x8_trace.c. Requires U8X8_WITH_RECORDER.
+  
+  Usage:
+    u8x8_Setup(...) or u8g2_Setup_...();
+    u8x8_ConnectByteRecorder(u8x8, &recorder, buf, sizeof(buf), time_cb);
+    u8x8_InitDisplay(u8x8);
+    ... draw and send one frame ...
+    u8x8_ByteRecorderMarkFrame(u8x8);
+*/
+
+#ifdef U8X8_WITH_RECORDER
+
+static void u8x8_byte_recorder_add(u8x8_byte_recorder_t *r, uint8_t type, uint8_t cnt, const uint8_t *data)
+{
+  uint32_t now, delta, size;
+  uint8_t *p;
+  
+  now = 0;
+  if ( r->time_cb != NULL )
+    now = r->time_cb();
+  delta = now - r->last_time;
+  
+  /* worst case size: type byte, 5 varint bytes, cnt byte, data */
+  size = 1+5+1+cnt;
+  if ( r->len + size > r->size )
+  {
+    r->dropped++;
+    return;
+  }
+  r->last_time = now;
+  
+  p = r->buf + r->len;
+  if ( delta < 31 )
+  {
+    *p++ = type | (uint8_t)(delta << 3);
+  }
+  else
+  {
+    *p++ = type | (31 << 3);
+    while( delta >= 128 )
+    {
+      *p++ = (uint8_t)(delta & 127) | 128;
+      delta >>= 7;
+    }
+    *p++ = (uint8_t)delta;
+  }
+  
+  if ( type == U8X8_TRACE_SET_DC )
+  {
+    *p++ = cnt;
+  }
+  else if ( type == U8X8_TRACE_SEND )
+  {
+    *p++ = cnt;
+    while( cnt > 0 )
+    {
+      *p++ = *data++;
+      cnt--;
+    }
+  }
+  r->len = p - r->buf;
+}
+
+uint8_t u8x8_byte_recorder(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_byte_recorder_t *r = u8x8->recorder;
+  if ( r == NULL )
+    return 0;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      u8x8_byte_recorder_add(r, U8X8_TRACE_SEND, arg_int, (const uint8_t *)arg_ptr);
+      break;
+    case U8X8_MSG_BYTE_INIT:
+      u8x8_byte_recorder_add(r, U8X8_TRACE_INIT, 0, NULL);
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      u8x8_byte_recorder_add(r, U8X8_TRACE_SET_DC, arg_int, NULL);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_byte_recorder_add(r, U8X8_TRACE_START_TRANSFER, 0, NULL);
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_byte_recorder_add(r, U8X8_TRACE_END_TRANSFER, 0, NULL);
+      break;
+  }
+  return r->next_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+/* size: at least U8X8_TRACE_HEADER_SIZE, must be called after the setup procedure */
+void u8x8_ConnectByteRecorder(u8x8_t *u8x8, u8x8_byte_recorder_t *recorder, uint8_t *buf, uint32_t size, u8x8_recorder_time_cb time_cb)
+{
+  if ( u8x8->byte_cb == u8x8_byte_recorder )
+    return;	/* do nothing, recorder already installed */
+  
+  recorder->next_cb = u8x8->byte_cb;
+  recorder->time_cb = time_cb;
+  recorder->buf = buf;
+  recorder->size = size;
+  recorder->len = 0;
+  recorder->dropped = 0;
+  recorder->last_time = 0;
+  if ( time_cb != NULL )
+    recorder->last_time = time_cb();
+  
+  if ( size >= U8X8_TRACE_HEADER_SIZE )
+  {
+    buf[0] = 'u';
+    buf[1] = '8';
+    buf[2] = 't';
+    buf[3] = 'r';
+    buf[4] = U8X8_TRACE_VERSION;
+    buf[5] = u8x8->i2c_address;
+    buf[6] = u8x8_GetCols(u8x8);
+    buf[7] = u8x8_GetRows(u8x8);
+    recorder->len = U8X8_TRACE_HEADER_SIZE;
+  }
+  
+  u8x8->recorder = recorder;
+  u8x8->byte_cb = u8x8_byte_recorder;
+}
+
+void u8x8_DisconnectByteRecorder(u8x8_t *u8x8)
+{
+  if ( u8x8->byte_cb != u8x8_byte_recorder || u8x8->recorder == NULL )
+    return;
+  u8x8->byte_cb = u8x8->recorder->next_cb;
+  u8x8->recorder = NULL;
+}
+
+void u8x8_ByteRecorderMarkFrame(u8x8_t *u8x8)
+{
+  if ( u8x8->byte_cb != u8x8_byte_recorder || u8x8->recorder == NULL )
+    return;
+  u8x8_byte_recorder_add(u8x8->recorder, U8X8_TRACE_FRAME, 0, NULL);
+}
+
+#endif /* U8X8_WITH_RECORDER */
+
+
 /*=========================================*/
 
 
@@ -163,6 +311,87 @@ uint8_t u8x8_byte_4wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 
 /*=========================================*/
 
+/*
+  Fast bit banging 
+  
+  The gpio and delay callback may provide set and clear registers for the 
+  clock and data line with U8X8_MSG_GPIO_FAST_IO. If this is the case, each byte is
+  shifted out with direct register writes, without calling the gpio callback for each edge.
+  Otherwise, the generic procedures u8x8_byte_4wire_sw_spi and u8x8_byte_sw_i2c are used.
+*/
+
+static uint8_t u8x8_get_fast_io(u8x8_t *u8x8, uint8_t type, u8x8_fast_io_t *io)
+{
+  io->set_reg = NULL;
+  io->clr_reg = NULL;
+  io->delay_cnt = 0;
+  if ( u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_GPIO_FAST_IO, type, (void *)io) == 0 )
+    return 0;
+  if ( io->set_reg == NULL || io->clr_reg == NULL )
+    return 0;
+  return 1;
+}
+
+static void u8x8_fast_io_delay(uint16_t cnt) U8X8_NOINLINE;
+static void u8x8_fast_io_delay(uint16_t cnt)
+{
+  volatile uint16_t i = cnt;
+  while( i > 0 )
+    i--;
+}
+
+/* same signals as u8x8_byte_4wire_sw_spi, but without gpio callback per edge */
+uint8_t u8x8_byte_4wire_sw_spi_fast(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_fast_io_t io;
+  volatile uint32_t *clock_prepare_reg;
+  volatile uint32_t *clock_takeover_reg;
+  uint32_t clock_mask, data_mask;
+  uint8_t i, b;
+  uint8_t *data;
+  
+  if ( msg != U8X8_MSG_BYTE_SEND || u8x8_get_fast_io(u8x8, U8X8_FAST_IO_SPI, &io) == 0 )
+    return u8x8_byte_4wire_sw_spi(u8x8, msg, arg_int, arg_ptr);
+  
+  if ( u8x8_GetSPIClockPhase(u8x8) )
+  {
+    clock_prepare_reg = io.clr_reg;
+    clock_takeover_reg = io.set_reg;
+  }
+  else
+  {
+    clock_prepare_reg = io.set_reg;
+    clock_takeover_reg = io.clr_reg;
+  }
+  clock_mask = io.clock_mask;
+  data_mask = io.data_mask;
+  
+  data = (uint8_t *)arg_ptr;
+  while( arg_int > 0 )
+  {
+    b = *data;
+    data++;
+    arg_int--;
+    for( i = 0; i < 8; i++ )
+    {
+      if ( b & 128 )
+	*io.set_reg = data_mask;
+      else
+	*io.clr_reg = data_mask;
+      b <<= 1;
+      *clock_prepare_reg = clock_mask;
+      if ( io.delay_cnt != 0 )
+	u8x8_fast_io_delay(io.delay_cnt);
+      *clock_takeover_reg = clock_mask;
+      if ( io.delay_cnt != 0 )
+	u8x8_fast_io_delay(io.delay_cnt);
+    }
+  }
+  return 1;
+}
+
+/*=========================================*/
+
 uint8_t u8x8_byte_8bit_6800mode(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   uint8_t i, b;
@@ -612,6 +841,69 @@ uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
   return 1;
 }
 
+/* same signals as i2c_write_byte(), but with direct register writes, see u8x8_byte_4wire_sw_spi_fast */
+static void i2c_fast_write_byte(const u8x8_fast_io_t *io, uint8_t b)
+{
+  uint8_t i;
+  for( i = 0; i < 8; i++ )
+  {
+    if ( b & 128 )
+      *io->set_reg = io->data_mask;
+    else
+      *io->clr_reg = io->data_mask;
+    b <<= 1;
+    if ( io->delay_cnt != 0 )
+      u8x8_fast_io_delay(io->delay_cnt);
+    *io->set_reg = io->clock_mask;
+    if ( io->delay_cnt != 0 )
+      u8x8_fast_io_delay(io->delay_cnt);
+    *io->clr_reg = io->clock_mask;
+  }
+  
+  /* ack cycle, ack is ignored */
+  *io->set_reg = io->data_mask;
+  if ( io->delay_cnt != 0 )
+    u8x8_fast_io_delay(io->delay_cnt);
+  *io->set_reg = io->clock_mask;
+  if ( io->delay_cnt != 0 )
+  {
+    u8x8_fast_io_delay(io->delay_cnt);
+    u8x8_fast_io_delay(io->delay_cnt);
+  }
+  *io->clr_reg = io->clock_mask;
+}
+
+uint8_t u8x8_byte_sw_i2c_fast(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_fast_io_t io;
+  uint8_t *data;
+
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      if ( u8x8_get_fast_io(u8x8, U8X8_FAST_IO_I2C, &io) == 0 )
+	return u8x8_byte_sw_i2c(u8x8, msg, arg_int, arg_ptr);
+      data = (uint8_t *)arg_ptr;
+      while( arg_int > 0 )
+      {
+	i2c_fast_write_byte(&io, *data);
+	data++;
+	arg_int--;
+      }
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      i2c_start(u8x8);
+      if ( u8x8_get_fast_io(u8x8, U8X8_FAST_IO_I2C, &io) == 0 )
+	i2c_write_byte(u8x8, u8x8_GetI2CAddress(u8x8));
+      else
+	i2c_fast_write_byte(&io, u8x8_GetI2CAddress(u8x8));
+      break;
+    default:
+      return u8x8_byte_sw_i2c(u8x8, msg, arg_int, arg_ptr);
+  }
+  return 1;
+}
+
 /*=========================================*/
 
 /* alternative i2c byte procedure */
@@ -164,25 +164,11 @@ static const u8x8_display_info_t u8x8_il3820_296x128_display_info =
 };
 
 
-static uint8_t *u8x8_convert_tile_for_il3820(uint8_t *t)
-{
-  uint8_t i;
-  static uint8_t buf[8];
-  uint8_t *pbuf = buf;
-
-  for( i = 0; i < 8; i++ )
-  {
-    *pbuf++ = ~(*t++);
-  }
-  return buf;
-}
-
 static void u8x8_d_il3820_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr) U8X8_NOINLINE;
 static void u8x8_d_il3820_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
 {
   uint16_t x;
-  uint8_t c, page;
-  uint8_t *ptr;
+  uint8_t page;
   u8x8_cad_StartTransfer(u8x8);
 
   page = u8x8->display_info->tile_height;
@@ -205,20 +191,8 @@ static void u8x8_d_il3820_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr
 
   u8x8_cad_SendCmd(u8x8, 0x024 );
   
-  do
-  {
-    c = ((u8x8_tile_t *)arg_ptr)->cnt;
-    ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
-    do
-    {
-      u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_il3820(ptr));
-      ptr += 8;
-      x += 8;
-      c--;
-    } while( c > 0 );
-    
-    arg_int--;
-  } while( arg_int > 0 );
+  /* all tiles of this message are sent with one or two data transfers */
+  u8x8_d_helper_send_inverted_tiles(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
   
   u8x8_cad_EndTransfer(u8x8);
 }
@@ -237,6 +211,33 @@ static const uint8_t u8x8_d_il3820_exec_1000dly_seq[] = {
   U8X8_END()             			/* end of sequence */
 };
 
+/*
+  partial update LUT, numbers based on the Waveshare demo code.
+  Only pixels which change their color are driven. The full refresh 
+  sequences always load their own LUT, so they are not affected by this LUT.
+  TS_Sum is 20, which is about 420ms for the 296x128 display (see above)
+*/
+static const uint8_t u8x8_d_il3820_partial_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  U8X8_C(0x32),	/* write LUT register*/
+  U8X8_A(0x10), U8X8_A(0x18), U8X8_A(0x18), U8X8_A(0x08), U8X8_A(0x18),
+  U8X8_A(0x18), U8X8_A(0x08), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), 
+  U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), 
+  U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), 
+  
+  U8X8_A(0x13), U8X8_A(0x14), U8X8_A(0x44), U8X8_A(0x12), U8X8_A(0x00), 
+  U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00),
+
+  U8X8_CA(0x22, 0x04),	/* display update seq. option: pattern display */
+  U8X8_C(0x20),	/* execute sequence */
+  
+  U8X8_DLY(250),	/* delay for 500ms */
+  U8X8_DLY(250),
+  
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_END()             			/* end of sequence */
+};
+
 static void u8x8_d_il3820_first_init(u8x8_t *u8x8)
 {
       u8x8_ClearDisplay(u8x8);
@@ -402,6 +403,9 @@ uint8_t u8x8_d_il3820_296x128(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
     case U8X8_MSG_DISPLAY_REFRESH:
       u8x8_cad_SendSequence(u8x8, u8x8_d_il3820_to_display_seq);
       break;
+    case U8X8_MSG_DISPLAY_REFRESH_PARTIAL:
+      u8x8_cad_SendSequence(u8x8, u8x8_d_il3820_partial_seq);
+      break;
     default:
       return 0;
   }
@@ -542,6 +546,9 @@ uint8_t u8x8_d_il3820_v2_296x128(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, voi
     case U8X8_MSG_DISPLAY_REFRESH:
       u8x8_cad_SendSequence(u8x8, u8x8_d_il3820_v2_to_display_seq);
       break;
+    case U8X8_MSG_DISPLAY_REFRESH_PARTIAL:
+      u8x8_cad_SendSequence(u8x8, u8x8_d_il3820_partial_seq);
+      break;
     default:
       return 0;
   }
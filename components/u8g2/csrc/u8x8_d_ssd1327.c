@@ -85,43 +85,62 @@ static const uint8_t u8x8_d_ssd1327_winstar_96x64_flip1_seq[] = {
   U8X8_END()             			/* end of sequence */
 };
 
+/*
+  The tiles of one DRAW_TILE message are sent to a single RAM window (column and row address).
+  The controller fills the window line by line, so the tiles are converted pixel row by 
+  pixel row into u8x8_ssd1327_row_buf. As many pixel rows as possible are collected in
+  u8x8_ssd1327_row_buf before they are sent with one data transfer.
+  u8x8_ssd1327_row_buf can hold one pixel row of a 128 pixel wide display.
+*/
+
+#define U8X8_SSD1327_ROW_BUF_SIZE 64
+
+static uint8_t u8x8_ssd1327_row_buf[U8X8_SSD1327_ROW_BUF_SIZE];
+
+/* gray values for two neighbour pixel, index bit 0: left pixel, bit 1: right pixel */
+static const uint8_t u8x8_ssd1327_pair_to_gray[4] = { 0x00, 0xf0, 0x0f, 0xff };
+
 /*
   input:
-    one tile (8 Bytes)
+    cnt tiles (8 Bytes each), row: pixel row within the tiles (0..7)
   output:
-    Tile for ssd1327 (32 Bytes)
+    pixel row for ssd1327 at dest (4 Bytes for each tile)
 */
+static void u8x8_ssd1327_tiles_to_row(uint8_t *dest, uint8_t *ptr, uint8_t cnt, uint8_t row)
+{
+  uint8_t a, b, j;
+  do
+  {
+    for( j = 0; j < 4; j++ )
+    {
+      a = *ptr++ >> row;
+      b = *ptr++ >> row;
+      *dest++ = u8x8_ssd1327_pair_to_gray[(a & 1) | ((b & 1) << 1)];
+    }
+    cnt--;
+  } while( cnt > 0 );
+}
 
-static uint8_t u8x8_ssd1327_8to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1327_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
+/*
+  send cnt tiles to the current RAM window
+  cnt*4 must not exceed U8X8_SSD1327_ROW_BUF_SIZE
+*/
+static void u8x8_ssd1327_send_tiles(u8x8_t *u8x8, uint8_t *ptr, uint8_t cnt)
 {
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
+  uint8_t row;
+  uint8_t len = cnt*4;
+  uint8_t pos = 0;
+  for( row = 0; row < 8; row++ )
   {
-    dest = u8x8_ssd1327_8to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
+    if ( pos + len > U8X8_SSD1327_ROW_BUF_SIZE )
     {
-      v = 0;
-      if ( a&1 ) v |= 0xf0;
-      if ( b&1 ) v |= 0x0f;
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
+      u8x8_cad_SendData(u8x8, pos, u8x8_ssd1327_row_buf);
+      pos = 0;
     }
+    u8x8_ssd1327_tiles_to_row(u8x8_ssd1327_row_buf+pos, ptr, cnt, row);
+    pos += len;
   }
-  
-  return u8x8_ssd1327_8to32_dest_buf;
+  u8x8_cad_SendData(u8x8, pos, u8x8_ssd1327_row_buf);
 }
 
 
@@ -129,7 +148,7 @@ static uint8_t *u8x8_ssd1327_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
 
 static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  uint8_t x, y, c;
+  uint8_t x, y, c, n;
   uint8_t *ptr;
   switch(msg)
   {
@@ -179,15 +198,19 @@ static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t a
 
 	do
 	{
+	  n = c;
+	  if ( n > U8X8_SSD1327_ROW_BUF_SIZE/4 )
+	    n = U8X8_SSD1327_ROW_BUF_SIZE/4;
+	  
 	  u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
 	  u8x8_cad_SendArg(u8x8, x );	/* start */
-	  u8x8_cad_SendArg(u8x8, x+3 );	/* end */
+	  u8x8_cad_SendArg(u8x8, x+4*n-1 );	/* end */
 
+	  u8x8_ssd1327_send_tiles(u8x8, ptr, n);
 	  
-	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1327_8to32(u8x8, ptr));
-	  ptr += 8;
-	  x += 4;
-	  c--;
+	  ptr += n*8;
+	  x += n*4;
+	  c -= n;
 	} while( c > 0 );
 	
 	//x += 4;
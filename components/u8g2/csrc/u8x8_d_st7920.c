@@ -38,6 +38,7 @@
   
 */
 #include "u8x8.h"
+#include <string.h>
 
 
 
@@ -79,10 +80,135 @@ static const uint8_t u8x8_d_st7920_powersave1_seq[] = {
 };
 
 
-uint8_t u8x8_d_st7920_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+#if U8X8_ST7920_LINE_CACHE_SIZE > 0
+/*
+  Copy of the lines, which have been sent to the GDRAM, pixel_height*tile_width bytes.
+  The cache belongs to one display only: If another ST7920 display is used, the
+  cache is cleared.
+*/
+static u8x8_t *u8x8_st7920_cache_owner = NULL;
+static uint8_t u8x8_st7920_cache[U8X8_ST7920_LINE_CACHE_SIZE];
+static uint8_t u8x8_st7920_cache_valid[8];		/* one bit per line, max 64 lines */
+
+/* 
+  compare the line with the cache and update the cache.
+  returns the range of bytes in [*first, *last), which must be sent. *first == *last: no change
+*/
+static void u8x8_st7920_cache_line(u8x8_t *u8x8, uint8_t line, uint8_t col, uint8_t cnt, const uint8_t *data, uint8_t *first, uint8_t *last)
+{
+  uint8_t *cache;
+  uint8_t w = u8x8->display_info->tile_width;
+  uint8_t mask = 1<<(line&7);
+  uint8_t f, l;
+  
+  *first = 0;
+  *last = cnt;
+  if ( u8x8_st7920_cache_owner != u8x8 )
+  {
+    memset(u8x8_st7920_cache_valid, 0, sizeof(u8x8_st7920_cache_valid));
+    u8x8_st7920_cache_owner = u8x8;
+  }
+  if ( (uint16_t)u8x8->display_info->pixel_height * w > U8X8_ST7920_LINE_CACHE_SIZE )
+    return;	/* cache too small for this display */
+  if ( line >= 64 || (uint16_t)col + cnt > w )
+    return;
+  
+  cache = u8x8_st7920_cache + (uint16_t)line * w + col;
+  if ( u8x8_st7920_cache_valid[line>>3] & mask )
+  {
+    f = 0;
+    while( f < cnt && cache[f] == data[f] )
+      f++;
+    l = cnt;
+    while( l > f && cache[l-1] == data[l-1] )
+      l--;
+    /* the GDRAM is addressed in units of 16 bit */
+    f &= 0xfe;
+    l = (l+1) & 0xfe;
+    if ( l > cnt )
+      l = cnt;
+    if ( f >= l )
+      l = f;		/* no change */
+    *first = f;
+    *last = l;
+  }
+  else if ( col == 0 && cnt == w )
+  {
+    u8x8_st7920_cache_valid[line>>3] |= mask;
+  }
+  memcpy(cache, data, cnt);
+}
+#endif
+
+/* 
+  Tile structure is reused here for the ST7920, however u8x8 is not supported 
+  tile_ptr points to data which has cnt*8 bytes (same as SSD1306 tiles)
+  Buffer is expected to have 8 lines of code fitting to the ST7920 internal memory
+  "cnt" includes the number of horizontal bytes. width is equal to cnt*8
+  Also important: Width must be a multiple of 16 (ST7920 requirement), so cnt must be even.
+  
+  The ST7920 increments only the horizontal address, so each line requires
+  the y and x position. Lines which did not change since the last transfer 
+  are not sent (see U8X8_ST7920_LINE_CACHE_SIZE), changed lines are only sent from the 
+  first to the last changed 16 bit word.
+  
+  TODO: Consider arg_int, however arg_int is not used by u8g2
+*/
+static void u8x8_d_st7920_draw_tile(u8x8_t *u8x8, u8x8_tile_t *tile) U8X8_NOINLINE;
+static void u8x8_d_st7920_draw_tile(u8x8_t *u8x8, u8x8_tile_t *tile)
 {
   uint8_t x, y, c, i;
+  uint8_t first, last;
+  uint8_t is_started = 0;
   uint8_t *ptr;
+  
+  y = tile->y_pos;
+  y*=8;
+  x = tile->x_pos;
+  x /= 2;		/* not sure whether this is a clever idea, problem is, the ST7920 can address only every second tile */
+  c = tile->cnt;	/* number of tiles */
+  ptr = tile->tile_ptr;	/* data ptr to the tiles */
+
+  for( i = 0; i < 8; i++ )
+  {
+#if U8X8_ST7920_LINE_CACHE_SIZE > 0
+    u8x8_st7920_cache_line(u8x8, y+i, x*2, c, ptr, &first, &last);
+#else
+    first = 0;
+    last = c;
+#endif
+    if ( first < last )
+    {
+      if ( is_started == 0 )
+      {
+	u8x8_cad_StartTransfer(u8x8);
+	/* The following byte is sent to allow the ST7920 to sync up with the data */
+	/* it solves some issues with garbage data */
+	u8x8_cad_SendCmd(u8x8, 0x03e );	/* enable extended mode */
+	u8x8_cad_SendCmd(u8x8, 0x03e );	/* enable extended mode, issue 487 */
+	is_started = 1;
+      }
+      if ( y >= 32 )	/* this is the adjustment for 128x64 displays */
+      {
+	u8x8_cad_SendCmd(u8x8, 0x080 | (y+i-32) );      /* y pos  */
+	u8x8_cad_SendCmd(u8x8, 0x080 | (x+8+first/2) );      /* set x pos */
+      }
+      else
+      {
+	u8x8_cad_SendCmd(u8x8, 0x080 | (y+i) );      /* y pos  */
+	u8x8_cad_SendCmd(u8x8, 0x080 | (x+first/2) );      /* set x pos */
+      }
+      u8x8_cad_SendData(u8x8, last-first, ptr+first);	/* note: SendData can not handle more than 255 bytes, send one line of data */
+    }
+    ptr += c;
+  }
+
+  if ( is_started )
+    u8x8_cad_EndTransfer(u8x8);
+}
+
+uint8_t u8x8_d_st7920_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
   switch(msg)
   {
     /* U8X8_MSG_DISPLAY_SETUP_MEMORY is handled by the calling function */
@@ -91,6 +217,9 @@ uint8_t u8x8_d_st7920_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       break;
     */
     case U8X8_MSG_DISPLAY_INIT:
+#if U8X8_ST7920_LINE_CACHE_SIZE > 0
+      u8x8_st7920_cache_owner = NULL;	/* content of the GDRAM is not known */
+#endif
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_st7920_init_seq);
       break;
@@ -101,50 +230,7 @@ uint8_t u8x8_d_st7920_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 	u8x8_cad_SendSequence(u8x8, u8x8_d_st7920_powersave1_seq);
       break;
     case U8X8_MSG_DISPLAY_DRAW_TILE:
-      y = (((u8x8_tile_t *)arg_ptr)->y_pos);
-      y*=8;
-      x = ((u8x8_tile_t *)arg_ptr)->x_pos;
-      x /= 2;		/* not sure whether this is a clever idea, problem is, the ST7920 can address only every second tile */
-    
-      if ( y >= 32 )	/* this is the adjustment for 128x64 displays */
-      {
-	y-=32;
-	x+=8;
-      }
-    
-      u8x8_cad_StartTransfer(u8x8);
-        
-
-      /* 
-	Tile structure is reused here for the ST7920, however u8x8 is not supported 
-	tile_ptr points to data which has cnt*8 bytes (same as SSD1306 tiles)
-	Buffer is expected to have 8 lines of code fitting to the ST7920 internal memory
-	"cnt" includes the number of horizontal bytes. width is equal to cnt*8
-	Also important: Width must be a multiple of 16 (ST7920 requirement), so cnt must be even.
-	
-	TODO: Consider arg_int, however arg_int is not used by u8g2
-      */
-      c = ((u8x8_tile_t *)arg_ptr)->cnt;	/* number of tiles */
-      ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;	/* data ptr to the tiles */
-      /* The following byte is sent to allow the ST7920 to sync up with the data */
-      /* it solves some issues with garbage data */
-      u8x8_cad_SendCmd(u8x8, 0x03e );	/* enable extended mode */
-      u8x8_cad_SendCmd(u8x8, 0x03e );	/* enable extended mode, issue 487 */
-      for( i = 0; i < 8; i++ )
-      {
-	//u8x8_cad_SendCmd(u8x8, 0x03e );	/* enable extended mode */
-	u8x8_cad_SendCmd(u8x8, 0x080 | (y+i) );      /* y pos  */
-	u8x8_cad_SendCmd(u8x8, 0x080 | x );      /* set x pos */
-	c = ((u8x8_tile_t *)arg_ptr)->cnt;	/* number of tiles */
-
-	//u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, 200, NULL);	/* extra dely required */
-	u8x8_cad_SendData(u8x8, c, ptr);	/* note: SendData can not handle more than 255 bytes, send one line of data */
-	ptr += c;
-	//u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, 200, NULL);	/* extra dely required */
-      }
-
-      u8x8_cad_EndTransfer(u8x8);
-
+      u8x8_d_st7920_draw_tile(u8x8, (u8x8_tile_t *)arg_ptr);
       break;
     default:
       return 0;
@@ -39,6 +39,7 @@
 
 
 #include "u8x8.h"
+#include <string.h>
 
 
 /*==========================================*/
@@ -76,17 +77,63 @@ void u8x8_d_helper_display_init(u8x8_t *u8x8)
       u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, u8x8->display_info->post_reset_wait_ms);
 }    
 
+/*
+  this is a helper function for the U8X8_MSG_DISPLAY_DRAW_TILE function of display controllers,
+  which expect inverted tiles in the same order as u8x8 (e-paper: SSD1607, IL3820).
+  It must be called after the RAM cursor has been set and the write RAM command was sent.
+  The tiles (including the arg_int repetitions) are collected and sent with one data transfer 
+  for up to U8X8_D_HELPER_INV_TILE_CNT tiles. Tiles are inverted with 32 bit operations,
+  memcpy() is used for the access, because tile_ptr might not be aligned.
+*/
+#define U8X8_D_HELPER_INV_TILE_CNT 25
+
+void u8x8_d_helper_send_inverted_tiles(u8x8_t *u8x8, uint8_t arg_int, u8x8_tile_t *tile)
+{
+  static uint32_t buf[U8X8_D_HELPER_INV_TILE_CNT*2];
+  uint32_t w[2];
+  uint8_t pos = 0;
+  uint8_t c;
+  uint8_t *ptr;
+  
+  do
+  {
+    c = tile->cnt;
+    ptr = tile->tile_ptr;
+    do
+    {
+      if ( pos >= U8X8_D_HELPER_INV_TILE_CNT )
+      {
+	u8x8_cad_SendData(u8x8, pos*8, (uint8_t *)buf);
+	pos = 0;
+      }
+      memcpy(w, ptr, 8);
+      buf[pos*2] = ~w[0];
+      buf[pos*2+1] = ~w[1];
+      ptr += 8;
+      pos++;
+      c--;
+    } while( c > 0 );
+    arg_int--;
+  } while( arg_int > 0 );
+  
+  u8x8_cad_SendData(u8x8, pos*8, (uint8_t *)buf);
+}
+
 /*==========================================*/
 /* official functions */
 
 uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr)
 {
   u8x8_tile_t tile;
+  uint8_t r;
+  U8X8_TIMING_BEGIN(u8x8);
   tile.x_pos = x;
   tile.y_pos = y;
   tile.cnt = cnt;
   tile.tile_ptr = tile_ptr;
-  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
+  r = u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
+  U8X8_TIMING_END(u8x8, U8X8_TIMING_DRAW_TILE, (uint32_t)cnt*8);
+  return r;
 }
 
 /* should be implemented as macro */
@@ -158,6 +205,12 @@ void u8x8_RefreshDisplay(u8x8_t *u8x8)
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_REFRESH, 0, NULL);  
 }
 
+/* returns 0, if the display does not support a partial refresh, nothing is sent in this case */
+uint8_t u8x8_RefreshDisplayPartial(u8x8_t *u8x8)
+{
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_REFRESH_PARTIAL, 0, NULL);  
+}
+
 void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)
 {
   u8x8_tile_t tile;
@@ -105,6 +105,12 @@ void u8x8_SetupDefaults(u8x8_t *u8x8)
     u8x8->bus_clock = 0;		/* issue 769 */
     u8x8->i2c_address = 255;
     u8x8->debounce_default_pin_state = 255;	/* assume all low active buttons */
+#ifdef U8X8_WITH_RECORDER
+    u8x8->recorder = NULL;
+#endif
+#ifdef U8X8_WITH_TIMING
+    u8x8->timing = NULL;
+#endif
   
 #ifdef U8X8_USE_PINS 
   {
@@ -0,0 +1,192 @@
+/*
+
+  u8x8_timing.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  Optional time measurement of the display update, requires U8X8_WITH_TIMING.
+
+  Usage:
+    u8x8_timing_t timing;
+    u8g2_Setup_...(&u8g2, ...);
+    u8x8_timing_Init(u8g2_GetU8x8(&u8g2), &timing);
+    ... draw and send some frames ...
+    u8x8_timing_Print(&timing, out);
+
+  Durations are stored as 32 bit tick differences, so a single measurement
+  must be shorter than 2^32 ticks (about 26 seconds at 160 MHz, 4 seconds with
+  nanoseconds).
+  Without U8X8_WITH_TIMING, all hooks are empty macros.
+
+*/
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_TIMING
+
+#include <string.h>
+
+#ifndef U8X8_TIMING_GET_TICKS
+#if defined(ESP_PLATFORM)
+#include "esp_cpu.h"
+#define U8X8_TIMING_GET_TICKS() ((uint32_t)esp_cpu_get_cycle_count())
+#else
+#include <time.h>
+static uint32_t u8x8_timing_clock_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000000UL + (uint32_t)ts.tv_nsec;
+}
+#define U8X8_TIMING_GET_TICKS() u8x8_timing_clock_ns()
+#endif
+#endif
+
+uint32_t u8x8_timing_GetTicks(void)
+{
+  return U8X8_TIMING_GET_TICKS();
+}
+
+static void u8x8_timing_add(u8x8_timing_t *timing, uint8_t stage, uint32_t ticks, uint32_t bytes)
+{
+  u8x8_timing_stage_t *s = timing->stage + stage;
+  s->cnt++;
+  s->sum += ticks;
+  s->bytes += bytes;
+  if ( s->min > ticks )
+    s->min = ticks;
+  if ( s->max < ticks )
+    s->max = ticks;
+}
+
+/* wrapper for the byte callback of the display, the time of all byte messages is recorded */
+static uint8_t u8x8_timing_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint32_t start;
+  uint8_t r;
+  start = U8X8_TIMING_GET_TICKS();
+  r = u8x8->timing->byte_cb(u8x8, msg, arg_int, arg_ptr);
+  u8x8_timing_add(u8x8->timing, U8X8_TIMING_BYTE, U8X8_TIMING_GET_TICKS() - start, msg == U8X8_MSG_BYTE_SEND ? arg_int : 0);
+  return r;
+}
+
+void u8x8_timing_Reset(u8x8_timing_t *timing)
+{
+  uint8_t i;
+  memset(timing->stage, 0, sizeof(timing->stage));
+  for( i = 0; i < U8X8_TIMING_STAGE_CNT; i++ )
+    timing->stage[i].min = 0x0ffffffffUL;
+  timing->is_render = 0;
+}
+
+void u8x8_timing_Init(u8x8_t *u8x8, u8x8_timing_t *timing)
+{
+  u8x8_timing_Reset(timing);
+  if ( u8x8->byte_cb != u8x8_timing_byte_cb )
+  {
+    timing->byte_cb = u8x8->byte_cb;
+    u8x8->byte_cb = u8x8_timing_byte_cb;
+  }
+  else
+  {
+    timing->byte_cb = u8x8->timing->byte_cb;
+  }
+  u8x8->timing = timing;
+}
+
+uint32_t u8x8_timing_Begin(u8x8_t *u8x8)
+{
+  if ( u8x8->timing == NULL )
+    return 0;
+  return U8X8_TIMING_GET_TICKS();
+}
+
+void u8x8_timing_End(u8x8_t *u8x8, uint8_t stage, uint32_t start, uint32_t bytes)
+{
+  if ( u8x8->timing == NULL )
+    return;
+  u8x8_timing_add(u8x8->timing, stage, U8X8_TIMING_GET_TICKS() - start, bytes);
+}
+
+void u8x8_timing_StartRender(u8x8_t *u8x8)
+{
+  if ( u8x8->timing == NULL )
+    return;
+  u8x8->timing->render_start = U8X8_TIMING_GET_TICKS();
+  u8x8->timing->is_render = 1;
+}
+
+void u8x8_timing_EndRender(u8x8_t *u8x8)
+{
+  if ( u8x8->timing == NULL || u8x8->timing->is_render == 0 )
+    return;
+  u8x8_timing_add(u8x8->timing, U8X8_TIMING_RENDER, U8X8_TIMING_GET_TICKS() - u8x8->timing->render_start, 0);
+  u8x8->timing->is_render = 0;
+}
+
+static const char *u8x8_timing_ultoa(char *buf, uint32_t v)
+{
+  char *s = buf + 11;
+  *s = '\0';
+  do
+  {
+    s--;
+    *s = '0' + (v % 10);
+    v /= 10;
+  } while( v > 0 );
+  return s;
+}
+
+void u8x8_timing_Print(u8x8_timing_t *timing, void (*out)(const char *s))
+{
+  static const char *names[U8X8_TIMING_STAGE_CNT] = { "render", "font", "send", "draw_tile", "byte" };
+  char buf[12];
+  u8x8_timing_stage_t *s;
+  uint8_t i;
+
+  for( i = 0; i < U8X8_TIMING_STAGE_CNT; i++ )
+  {
+    s = timing->stage + i;
+    out(names[i]);
+    out(" cnt=");
+    out(u8x8_timing_ultoa(buf, s->cnt));
+    out(" min=");
+    out(u8x8_timing_ultoa(buf, s->cnt > 0 ? s->min : 0));
+    out(" avg=");
+    out(u8x8_timing_ultoa(buf, s->cnt > 0 ? (uint32_t)(s->sum / s->cnt) : 0));
+    out(" max=");
+    out(u8x8_timing_ultoa(buf, s->max));
+    out(" bytes=");
+    out(u8x8_timing_ultoa(buf, s->bytes));
+    out("\n");
+  }
+}
+
+#endif /* U8X8_WITH_TIMING */
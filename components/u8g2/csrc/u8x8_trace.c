@@ -0,0 +1,363 @@
+/*
+
+  u8x8_trace.c
+  
+  Analysis and replay of bus traces, written by u8x8_byte_recorder (u8x8_byte.c)
+  
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+  
+  
+*/
+
+#include "u8x8.h"
+#include <string.h>
+
+struct u8x8_trace_record_struct
+{
+  uint32_t delta;
+  const uint8_t *data;
+  uint8_t type;
+  uint8_t arg;		/* dc value or number of bytes */
+};
+typedef struct u8x8_trace_record_struct u8x8_trace_record_t;
+
+/* 
+  keeps track of command and data bytes. 
+  If the trace contains SET_DC messages, then the DC line decides (SPI and parallel interfaces).
+  Otherwise the first byte of each transfer is an i2c control byte (SSD13xx: 0x00 command, 0x40 data). 
+*/
+struct u8x8_trace_bus_struct
+{
+  uint8_t has_dc;
+  uint8_t dc;
+  uint8_t expect_ctrl;
+  uint8_t is_single;		/* i2c: control byte had Co=1, next byte is followed by another control byte */
+};
+typedef struct u8x8_trace_bus_struct u8x8_trace_bus_t;
+
+#define U8X8_TRACE_BYTE_CTRL 0
+#define U8X8_TRACE_BYTE_CMD 1
+#define U8X8_TRACE_BYTE_DATA 2
+
+/* returns NULL at the end of the trace or if the trace is corrupt */
+static const uint8_t *u8x8_trace_next(const uint8_t *p, const uint8_t *end, u8x8_trace_record_t *rec)
+{
+  uint8_t shift;
+  if ( p >= end )
+    return NULL;
+  rec->type = *p & 7;
+  rec->delta = *p >> 3;
+  rec->arg = 0;
+  rec->data = NULL;
+  p++;
+  if ( rec->delta == 31 )
+  {
+    rec->delta = 0;
+    shift = 0;
+    for(;;)
+    {
+      if ( p >= end || shift > 28 )
+	return NULL;
+      rec->delta |= (uint32_t)(*p & 127) << shift;
+      shift += 7;
+      if ( (*p++ & 128) == 0 )
+	break;
+    }
+  }
+  if ( rec->type == U8X8_TRACE_SET_DC || rec->type == U8X8_TRACE_SEND )
+  {
+    if ( p >= end )
+      return NULL;
+    rec->arg = *p++;
+  }
+  if ( rec->type == U8X8_TRACE_SEND )
+  {
+    if ( p + rec->arg > end )
+      return NULL;
+    rec->data = p;
+    p += rec->arg;
+  }
+  if ( rec->type > U8X8_TRACE_FRAME )
+    return NULL;
+  return p;
+}
+
+static const uint8_t *u8x8_trace_start(const uint8_t *trace, uint32_t len)
+{
+  if ( len < U8X8_TRACE_HEADER_SIZE )
+    return NULL;
+  if ( trace[0] != 'u' || trace[1] != '8' || trace[2] != 't' || trace[3] != 'r' || trace[4] != U8X8_TRACE_VERSION )
+    return NULL;
+  return trace + U8X8_TRACE_HEADER_SIZE;
+}
+
+static void u8x8_trace_bus_record(u8x8_trace_bus_t *bus, const u8x8_trace_record_t *rec)
+{
+  if ( rec->type == U8X8_TRACE_SET_DC )
+  {
+    bus->has_dc = 1;
+    bus->dc = rec->arg;
+  }
+  else if ( rec->type == U8X8_TRACE_START_TRANSFER && bus->has_dc == 0 )
+  {
+    bus->expect_ctrl = 1;
+  }
+}
+
+static uint8_t u8x8_trace_bus_byte(u8x8_trace_bus_t *bus, uint8_t b)
+{
+  if ( bus->has_dc )
+    return bus->dc ? U8X8_TRACE_BYTE_DATA : U8X8_TRACE_BYTE_CMD;
+  if ( bus->expect_ctrl )
+  {
+    bus->expect_ctrl = 0;
+    bus->is_single = (b & 0x80) ? 1 : 0;
+    bus->dc = (b & 0x40) ? 1 : 0;
+    return U8X8_TRACE_BYTE_CTRL;
+  }
+  if ( bus->is_single )
+    bus->expect_ctrl = 1;
+  return bus->dc ? U8X8_TRACE_BYTE_DATA : U8X8_TRACE_BYTE_CMD;
+}
+
+/* returns 0 if the trace is not valid */
+uint8_t u8x8_trace_Analyse(const uint8_t *trace, uint32_t len, u8x8_trace_stats_t *stats)
+{
+  const uint8_t *p = u8x8_trace_start(trace, len);
+  const uint8_t *end = trace + len;
+  u8x8_trace_record_t rec;
+  u8x8_trace_bus_t bus = { 0, 0, 0, 0 };
+  uint8_t i;
+  
+  memset(stats, 0, sizeof(u8x8_trace_stats_t));
+  if ( p == NULL )
+    return 0;
+  while( p < end )
+  {
+    p = u8x8_trace_next(p, end, &rec);
+    if ( p == NULL )
+      return 0;
+    stats->records++;
+    if ( stats->records > 1 )
+      stats->duration_us += rec.delta;
+    u8x8_trace_bus_record(&bus, &rec);
+    switch(rec.type)
+    {
+      case U8X8_TRACE_SET_DC:
+	stats->dc_changes++;
+	break;
+      case U8X8_TRACE_START_TRANSFER:
+	stats->transfers++;
+	break;
+      case U8X8_TRACE_FRAME:
+	stats->frames++;
+	break;
+      case U8X8_TRACE_SEND:
+	stats->sends++;
+	stats->bytes += rec.arg;
+	for( i = 0; i < rec.arg; i++ )
+	{
+	  switch(u8x8_trace_bus_byte(&bus, rec.data[i]))
+	  {
+	    case U8X8_TRACE_BYTE_CTRL: stats->ctrl_bytes++; break;
+	    case U8X8_TRACE_BYTE_CMD: stats->cmd_bytes++; break;
+	    default: stats->data_bytes++; break;
+	  }
+	}
+	break;
+    }
+  }
+  return 1;
+}
+
+/* 
+  returns the estimated time in microseconds on the wire for the complete trace
+  I2C: 9 bits per byte including ack, one address byte plus start and stop condition per transfer
+  SPI: 8 bits per byte
+*/
+uint32_t u8x8_trace_EstimateWireTime(const u8x8_trace_stats_t *stats, uint8_t bus, uint32_t bus_hz)
+{
+  uint64_t bits;
+  if ( bus_hz == 0 )
+    return 0;
+  if ( bus == U8X8_TRACE_BUS_I2C )
+    bits = ((uint64_t)stats->bytes + stats->transfers) * 9 + (uint64_t)stats->transfers * 2;
+  else
+    bits = (uint64_t)stats->bytes * 8;
+  return (uint32_t)((bits * 1000000UL) / bus_hz);
+}
+
+/*=========================================*/
+/* SSD1306 GRAM model */
+
+struct u8x8_trace_ssd1306_struct
+{
+  uint8_t *gram;
+  uint8_t col;
+  uint8_t page;
+  uint8_t col_start;
+  uint8_t col_end;
+  uint8_t page_start;
+  uint8_t page_end;
+  uint8_t mode;		/* 0: horizontal, 1: vertical, 2: page addressing */
+  uint8_t cmd;
+  uint8_t arg_cnt;	/* number of expected args for cmd */
+  uint8_t arg_pos;
+  uint8_t arg[6];
+};
+typedef struct u8x8_trace_ssd1306_struct u8x8_trace_ssd1306_t;
+
+static uint8_t u8x8_trace_ssd1306_arg_cnt(uint8_t cmd)
+{
+  switch(cmd)
+  {
+    case 0x20: case 0x81: case 0x8d: case 0xa8: case 0xad: case 0xd3:
+    case 0xd5: case 0xd6: case 0xd9: case 0xda: case 0xdb:
+      return 1;
+    case 0x21: case 0x22: case 0xa3:
+      return 2;
+    case 0x29: case 0x2a:
+      return 5;
+    case 0x26: case 0x27:
+      return 6;
+  }
+  return 0;
+}
+
+static void u8x8_trace_ssd1306_exec(u8x8_trace_ssd1306_t *m)
+{
+  uint8_t c = m->cmd;
+  if ( c < 0x10 )
+    m->col = (m->col & 0xf0) | c;
+  else if ( c < 0x20 )
+    m->col = (m->col & 0x0f) | ((c & 0x07) << 4);
+  else if ( c >= 0xb0 && c <= 0xb7 )
+    m->page = c & 7;
+  else if ( c == 0x20 )
+    m->mode = m->arg[0] & 3;
+  else if ( c == 0x21 )
+  {
+    m->col_start = m->arg[0] & 127;
+    m->col_end = m->arg[1] & 127;
+    m->col = m->col_start;
+  }
+  else if ( c == 0x22 )
+  {
+    m->page_start = m->arg[0] & 7;
+    m->page_end = m->arg[1] & 7;
+    m->page = m->page_start;
+  }
+}
+
+static void u8x8_trace_ssd1306_cmd(u8x8_trace_ssd1306_t *m, uint8_t b)
+{
+  if ( m->arg_pos < m->arg_cnt )
+  {
+    m->arg[m->arg_pos++] = b;
+    if ( m->arg_pos == m->arg_cnt )
+      u8x8_trace_ssd1306_exec(m);
+    return;
+  }
+  m->cmd = b;
+  m->arg_cnt = u8x8_trace_ssd1306_arg_cnt(b);
+  m->arg_pos = 0;
+  if ( m->arg_cnt == 0 )
+    u8x8_trace_ssd1306_exec(m);
+}
+
+static void u8x8_trace_ssd1306_data(u8x8_trace_ssd1306_t *m, uint8_t b)
+{
+  m->gram[(uint16_t)m->page*128 + (m->col & 127)] = b;
+  if ( m->mode == 1 )
+  {
+    m->page++;
+    if ( m->page > m->page_end )
+    {
+      m->page = m->page_start;
+      m->col++;
+      if ( m->col > m->col_end )
+	m->col = m->col_start;
+    }
+  }
+  else if ( m->mode == 0 )
+  {
+    m->col++;
+    if ( m->col > m->col_end )
+    {
+      m->col = m->col_start;
+      m->page++;
+      if ( m->page > m->page_end )
+	m->page = m->page_start;
+    }
+  }
+  else
+  {
+    m->col = (m->col + 1) & 127;
+  }
+}
+
+/* replays the trace into the 128x64 gram model, returns 0 if the trace is not valid */
+uint8_t u8x8_trace_ReplaySSD1306(const uint8_t *trace, uint32_t len, uint8_t *gram)
+{
+  const uint8_t *p = u8x8_trace_start(trace, len);
+  const uint8_t *end = trace + len;
+  u8x8_trace_record_t rec;
+  u8x8_trace_bus_t bus = { 0, 0, 0, 0 };
+  u8x8_trace_ssd1306_t m;
+  uint8_t i, b;
+  
+  if ( p == NULL )
+    return 0;
+  memset(&m, 0, sizeof(u8x8_trace_ssd1306_t));
+  m.gram = gram;
+  m.col_end = 127;
+  m.page_end = 7;
+  m.mode = 2;	/* reset value of the SSD1306 */
+  
+  while( p < end )
+  {
+    p = u8x8_trace_next(p, end, &rec);
+    if ( p == NULL )
+      return 0;
+    u8x8_trace_bus_record(&bus, &rec);
+    if ( rec.type != U8X8_TRACE_SEND )
+      continue;
+    for( i = 0; i < rec.arg; i++ )
+    {
+      b = rec.data[i];
+      switch(u8x8_trace_bus_byte(&bus, b))
+      {
+	case U8X8_TRACE_BYTE_CMD: u8x8_trace_ssd1306_cmd(&m, b); break;
+	case U8X8_TRACE_BYTE_DATA: u8x8_trace_ssd1306_data(&m, b); break;
+      }
+    }
+  }
+  return 1;
+}
@@ -0,0 +1,181 @@
+/*
+  Compare the buffer level fill procedures (u8g2_FillBufferBox, u8g2_ClearBufferBox,
+  u8g2_InvertBufferBox, u8g2_DitherBufferBox and u8g2_FillBuffer) with the same
+  output of u8g2_DrawBox() and u8g2_DrawPixel() for random boxes.
+  Both buffer layouts (SSD1306: vertical top lsb, ST7920: horizontal right lsb) are
+  tested in full buffer and page mode, with aligned and misaligned buffers.
+  Afterwards the speed of the pattern procedures is measured.
+  No hardware required, returns 1 if the output differs.
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TEST_CNT 4000
+#define BENCH_CNT 2000
+
+typedef void (*setup_fn)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+uint8_t ref_mem[1024+8];
+uint8_t test_mem[1024+8];
+
+double get_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* reference: draw the pattern pixel by pixel */
+void draw_pattern(u8g2_t *u8g2, int x, int y, int w, int h, const uint8_t *pattern)
+{
+  int xx, yy;
+  for( yy = y; yy < y+h && yy < u8g2_GetDisplayHeight(u8g2); yy++ )
+    for( xx = x; xx < x+w && xx < u8g2_GetDisplayWidth(u8g2); xx++ )
+    {
+      u8g2_SetDrawColor(u8g2, (pattern[yy & 7] & (128 >> (xx & 7))) ? 1 : 0);
+      u8g2_DrawPixel(u8g2, xx, yy);
+    }
+  u8g2_SetDrawColor(u8g2, 1);
+}
+
+/* reference: draw a box with the given color */
+void draw_box(u8g2_t *u8g2, int x, int y, int w, int h, uint8_t color)
+{
+  u8g2_SetDrawColor(u8g2, color);
+  u8g2_DrawBox(u8g2, x, y, w, h);
+  u8g2_SetDrawColor(u8g2, 1);
+}
+
+int test(const char *name, setup_fn setup, int misalign)
+{
+  u8g2_t ref, u8g2;
+  uint8_t *ref_buf = ref_mem + misalign;
+  uint8_t *buf = test_mem + misalign;
+  uint8_t pattern[8];
+  int size, width, height, pages, page;
+  int i, n, op, level, x, y, w, h;
+  int fails = 0;
+  
+  setup(&ref, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+  setup(&u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+  /* both objects would share the static buffer, replace it */
+  ref.tile_buf_ptr = ref_buf;
+  u8g2.tile_buf_ptr = buf;
+  size = u8g2_GetBufferSize(&u8g2);
+  width = u8g2_GetDisplayWidth(&u8g2);
+  height = u8g2_GetDisplayHeight(&u8g2);
+  pages = height / 8 / u8g2_GetBufferTileHeight(&u8g2);
+  
+  for( n = 0; n < TEST_CNT; n++ )
+  {
+    page = rand() % pages;
+    u8g2_SetBufferCurrTileRow(&ref, page * u8g2_GetBufferTileHeight(&ref));
+    u8g2_SetBufferCurrTileRow(&u8g2, page * u8g2_GetBufferTileHeight(&u8g2));
+    for( i = 0; i < size; i++ )
+      ref_buf[i] = buf[i] = rand();
+    x = rand() % (width + 10);
+    y = rand() % (height + 10);
+    w = rand() % (width + 4);
+    h = rand() % (height + 4);
+    for( i = 0; i < 8; i++ )
+      pattern[i] = rand();
+    op = rand() % 5;
+    switch(op)
+    {
+      case 0:
+	draw_pattern(&ref, x, y, w, h, pattern);
+	u8g2_FillBufferBox(&u8g2, x, y, w, h, pattern);
+	break;
+      case 1:
+	draw_box(&ref, x, y, w, h, 0);
+	u8g2_ClearBufferBox(&u8g2, x, y, w, h);
+	break;
+      case 2:
+	draw_box(&ref, x, y, w, h, 2);
+	u8g2_InvertBufferBox(&u8g2, x, y, w, h);
+	break;
+      case 3:
+	level = rand() % 65;
+	u8g2_GetDitherPattern(level, pattern);
+	draw_pattern(&ref, x, y, w, h, pattern);
+	u8g2_DitherBufferBox(&u8g2, x, y, w, h, level);
+	break;
+      default:
+	draw_pattern(&ref, 0, 0, width, height, u8g2_pattern_checkerboard);
+	u8g2_FillBuffer(&u8g2, u8g2_pattern_checkerboard);
+	break;
+    }
+    if ( memcmp(ref_buf, buf, size) != 0 )
+    {
+      if ( fails < 3 )
+	printf("%s misalign %d: op %d page %d x %d y %d w %d h %d differs\n", name, misalign, op, page, x, y, w, h);
+      fails++;
+    }
+  }
+  printf("%-20s misalign %d: %d/%d differ\n", name, misalign, fails, TEST_CNT);
+  return fails;
+}
+
+void bench(const char *name, setup_fn setup)
+{
+  u8g2_t u8g2;
+  uint8_t pattern[8];
+  int width, height;
+  int n, x, y;
+  double t0, t1, t2, t3, t4;
+  
+  setup(&u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+  u8g2.tile_buf_ptr = test_mem;
+  width = u8g2_GetDisplayWidth(&u8g2);
+  height = u8g2_GetDisplayHeight(&u8g2);
+  u8g2_GetDitherPattern(24, pattern);
+  
+  t0 = get_ns();
+  for( n = 0; n < BENCH_CNT; n++ )
+    for( y = 0; y < height; y++ )
+      for( x = 0; x < width; x++ )
+      {
+	u8g2_SetDrawColor(&u8g2, (pattern[y & 7] & (128 >> (x & 7))) ? 1 : 0);
+	u8g2_DrawPixel(&u8g2, x, y);
+      }
+  t1 = get_ns();
+  for( n = 0; n < BENCH_CNT; n++ )
+    u8g2_DitherBufferBox(&u8g2, 0, 0, width, height, 24);
+  t2 = get_ns();
+  u8g2_SetDrawColor(&u8g2, 2);
+  for( n = 0; n < BENCH_CNT; n++ )
+    for( y = 3; y < height-3; y++ )
+      u8g2_DrawBox(&u8g2, 5, y, width-10, 1);
+  t3 = get_ns();
+  for( n = 0; n < BENCH_CNT; n++ )
+    u8g2_InvertBufferBox(&u8g2, 5, 3, width-10, height-6);
+  t4 = get_ns();
+  
+  printf("%s dither: DrawPixel %.0f ns, DitherBufferBox %.0f ns (%.0fx)\n", 
+    name, (t1-t0)/BENCH_CNT, (t2-t1)/BENCH_CNT, (t1-t0)/(t2-t1));
+  printf("%s invert: DrawBox per row %.0f ns, InvertBufferBox %.0f ns (%.0fx)\n", 
+    name, (t3-t2)/BENCH_CNT, (t4-t3)/BENCH_CNT, (t3-t2)/(t4-t3));
+}
+
+int main(void)
+{
+  int misalign;
+  int fails = 0;
+  
+  srand(1);
+  for( misalign = 0; misalign < 4; misalign++ )
+  {
+    fails += test("ssd1306_72x40_f", u8g2_Setup_ssd1306_i2c_72x40_er_f, misalign);
+    fails += test("ssd1306_128x64_1", u8g2_Setup_ssd1306_128x64_noname_1, misalign);
+    fails += test("ssd1306_128x64_2", u8g2_Setup_ssd1306_128x64_noname_2, misalign);
+    fails += test("st7920_128x64_f", u8g2_Setup_st7920_s_128x64_f, misalign);
+    fails += test("st7920_128x64_1", u8g2_Setup_st7920_s_128x64_1, misalign);
+  }
+  bench("ssd1306_128x64_f", u8g2_Setup_ssd1306_128x64_noname_f);
+  bench("st7920_128x64_f", u8g2_Setup_st7920_s_128x64_f);
+  return fails != 0;
+}
@@ -0,0 +1,40 @@
+#include <linux-i2c.h>
+#include <u8g2.h>
+#include <stdio.h>
+
+/* 8 bit i2c address, 0x3c << 1 */
+#define SSD1306_ADDR  0x78
+#define I2C_ADAPTER 1
+#define FRAMES 100
+
+u8g2_t u8g2;
+u8x8_linux_i2c_t i2c_dev;
+
+int main (void)
+{
+	int i;
+
+	u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_linux_i2c_rdwr, u8x8_linux_i2c_delay);
+	u8x8_linux_i2c_Attach(u8g2_GetU8x8(&u8g2), &i2c_dev, I2C_ADAPTER, U8X8_LINUX_I2C_DEFER|U8X8_LINUX_I2C_MERGE_DATA);
+	u8g2_SetI2CAddress(&u8g2, SSD1306_ADDR);
+
+	u8g2_InitDisplay(&u8g2);
+	u8g2_SetPowerSave(&u8g2, 0);
+	u8x8_linux_i2c_Flush(u8g2_GetU8x8(&u8g2));
+	u8x8_linux_i2c_ResetStats(u8g2_GetU8x8(&u8g2));
+
+	u8g2_SetFont(&u8g2, u8g2_font_6x10_tf);
+	for( i = 0; i < FRAMES; i++ )
+	{
+		u8g2_ClearBuffer(&u8g2);
+		u8g2_DrawStr(&u8g2, 0, 12, "u8g2 I2C_RDWR");
+		u8g2_DrawBox(&u8g2, 0, 20, i % 128, 8);
+		u8g2_SendBuffer(&u8g2);
+		/* one ioctl per frame */
+		u8x8_linux_i2c_Flush(u8g2_GetU8x8(&u8g2));
+	}
+
+	u8x8_linux_i2c_PrintStats(u8g2_GetU8x8(&u8g2), stdout);
+	u8x8_linux_i2c_Detach(u8g2_GetU8x8(&u8g2));
+	return 0;
+}
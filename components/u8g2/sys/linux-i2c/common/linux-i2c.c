@@ -12,6 +12,7 @@
 #include <time.h>
 #include <u8x8.h>
 #include <unistd.h>
+#include "linux-i2c.h"
 
 
 #define BUFSIZ_I2C 32
@@ -111,6 +112,10 @@ u8x8_linux_i2c_delay(u8x8_t *u8x8,
 		return 0;
 	}
 
+	/* queued I2C_RDWR transfers must reach the display before the delay starts */
+	if ( u8x8_linux_i2c_Get(u8x8) != NULL )
+		u8x8_linux_i2c_Flush(u8x8);
+
 	while((ret = nanosleep(&req, &rem)) && errno == EINTR){
 		struct timespec tmp = req;
 		req = rem;
@@ -124,3 +129,215 @@ u8x8_linux_i2c_delay(u8x8_t *u8x8,
 	
 	return 1;
 }
+
+
+/*=========================================*/
+/* I2C_RDWR transport */
+
+static u8x8_linux_i2c_t *u8x8_linux_i2c_list = NULL;
+
+void u8x8_linux_i2c_Attach(u8x8_t *u8x8, u8x8_linux_i2c_t *dev, int adapter_nr, uint8_t flags)
+{
+	u8x8_linux_i2c_Detach(u8x8);
+	memset(dev, 0, sizeof(u8x8_linux_i2c_t));
+	dev->u8x8 = u8x8;
+	dev->file = -1;
+	dev->adapter_nr = adapter_nr;
+	dev->flags = flags;
+	dev->next = u8x8_linux_i2c_list;
+	u8x8_linux_i2c_list = dev;
+}
+
+void u8x8_linux_i2c_Detach(u8x8_t *u8x8)
+{
+	u8x8_linux_i2c_t **pp = &u8x8_linux_i2c_list;
+	while( *pp != NULL ) {
+		if ( (*pp)->u8x8 == u8x8 ) {
+			u8x8_linux_i2c_t *dev = *pp;
+			u8x8_linux_i2c_Flush(u8x8);
+			if ( dev->file >= 0 )
+				close(dev->file);
+			dev->file = -1;
+			*pp = dev->next;
+			return;
+		}
+		pp = &((*pp)->next);
+	}
+}
+
+u8x8_linux_i2c_t *u8x8_linux_i2c_Get(u8x8_t *u8x8)
+{
+	u8x8_linux_i2c_t *dev;
+	for( dev = u8x8_linux_i2c_list; dev != NULL; dev = dev->next )
+		if ( dev->u8x8 == u8x8 )
+			return dev;
+	return NULL;
+}
+
+static uint64_t u8x8_linux_i2c_now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* send all completed transfers with one ioctl, a transfer which is still open is kept in the buffer */
+static int u8x8_linux_i2c_flush_dev(u8x8_linux_i2c_t *dev)
+{
+	struct i2c_msg msgs[U8X8_LINUX_I2C_MAX_MSGS];
+	struct i2c_rdwr_ioctl_data rdwr;
+	uint64_t t;
+	uint16_t i;
+	uint16_t addr = u8x8_GetI2CAddress(dev->u8x8) >> 1;
+	int ret = 0;
+
+	if ( dev->msg_cnt > 0 ) {
+		for( i = 0; i < dev->msg_cnt; i++ ) {
+			msgs[i].addr = addr;
+			msgs[i].flags = 0;
+			msgs[i].len = dev->msg_len[i];
+			msgs[i].buf = dev->buf + dev->msg_start[i];
+			dev->stats.bytes += dev->msg_len[i];
+		}
+		rdwr.msgs = msgs;
+		rdwr.nmsgs = dev->msg_cnt;
+
+		t = u8x8_linux_i2c_now_ns();
+		ret = ioctl(dev->file, I2C_RDWR, &rdwr);
+		dev->stats.syscall_ns += u8x8_linux_i2c_now_ns() - t;
+		dev->stats.ioctls++;
+		dev->stats.msgs += dev->msg_cnt;
+		if ( ret < 0 ) {
+			dev->stats.errors++;
+			fprintf(stderr, "can't write %d i2c msgs: %s\n", dev->msg_cnt, strerror(errno));
+		}
+		dev->msg_cnt = 0;
+	}
+
+	if ( dev->in_transfer != 0 ) {
+		memmove(dev->buf, dev->buf + dev->transfer_start, dev->len - dev->transfer_start);
+		dev->len -= dev->transfer_start;
+		dev->transfer_start = 0;
+	} else {
+		dev->len = 0;
+		dev->transfer_start = 0;
+	}
+	return ret < 0 ? -1 : 0;
+}
+
+int u8x8_linux_i2c_Flush(u8x8_t *u8x8)
+{
+	u8x8_linux_i2c_t *dev = u8x8_linux_i2c_Get(u8x8);
+	if ( dev == NULL || dev->file < 0 )
+		return -1;
+	return u8x8_linux_i2c_flush_dev(dev);
+}
+
+void u8x8_linux_i2c_ResetStats(u8x8_t *u8x8)
+{
+	u8x8_linux_i2c_t *dev = u8x8_linux_i2c_Get(u8x8);
+	if ( dev != NULL )
+		memset(&(dev->stats), 0, sizeof(u8x8_linux_i2c_stats_t));
+}
+
+void u8x8_linux_i2c_PrintStats(u8x8_t *u8x8, FILE *fp)
+{
+	u8x8_linux_i2c_t *dev = u8x8_linux_i2c_Get(u8x8);
+	if ( dev == NULL )
+		return;
+	fprintf(fp, "i2c-%d: %u bytes, %u transfers, %u msgs, %u ioctls, %u errors, %llu us in syscalls\n",
+		dev->adapter_nr,
+		(unsigned)dev->stats.bytes, (unsigned)dev->stats.transfers,
+		(unsigned)dev->stats.msgs, (unsigned)dev->stats.ioctls,
+		(unsigned)dev->stats.errors,
+		(unsigned long long)(dev->stats.syscall_ns / 1000));
+}
+
+static void u8x8_linux_i2c_end_transfer(u8x8_linux_i2c_t *dev)
+{
+	uint16_t len = dev->len - dev->transfer_start;
+	uint16_t last;
+
+	dev->in_transfer = 0;
+	if ( len == 0 )
+		return;
+
+	if ( (dev->flags & U8X8_LINUX_I2C_MERGE_DATA) && dev->msg_cnt > 0 && dev->buf[dev->transfer_start] == 0x40 ) {
+		last = dev->msg_cnt - 1;
+		if ( dev->buf[dev->msg_start[last]] == 0x40 && dev->msg_start[last] + dev->msg_len[last] == dev->transfer_start ) {
+			/* drop the control byte and extend the previous data stream */
+			memmove(dev->buf + dev->transfer_start, dev->buf + dev->transfer_start + 1, len - 1);
+			dev->len--;
+			dev->msg_len[last] += len - 1;
+			dev->transfer_start = dev->len;
+			return;
+		}
+	}
+
+	dev->msg_start[dev->msg_cnt] = dev->transfer_start;
+	dev->msg_len[dev->msg_cnt] = len;
+	dev->msg_cnt++;
+	dev->transfer_start = dev->len;
+}
+
+uint8_t
+u8x8_byte_linux_i2c_rdwr(u8x8_t *u8x8,
+			 uint8_t msg,
+			 uint8_t arg_int,
+			 void *arg_ptr)
+{
+	u8x8_linux_i2c_t *dev = u8x8_linux_i2c_Get(u8x8);
+	unsigned long funcs;
+
+	if ( dev == NULL ) {
+		fprintf(stderr, "u8x8_byte_linux_i2c_rdwr: device not attached\n");
+		return 0;
+	}
+
+	switch(msg){
+	case U8X8_MSG_BYTE_SEND:
+		if ( dev->len + arg_int > U8X8_LINUX_I2C_BUF_SIZE ) {
+			u8x8_linux_i2c_flush_dev(dev);
+			if ( dev->len + arg_int > U8X8_LINUX_I2C_BUF_SIZE ) {
+				/* a single transfer is larger than the buffer: report, never truncate silently */
+				dev->stats.errors++;
+				fprintf(stderr, "i2c transfer exceeds %d bytes\n", U8X8_LINUX_I2C_BUF_SIZE);
+				return 0;
+			}
+		}
+		memcpy(dev->buf + dev->len, arg_ptr, arg_int);
+		dev->len += arg_int;
+		break;
+	case U8X8_MSG_BYTE_INIT:
+		snprintf(filename, sizeof(filename), "/dev/i2c-%d", dev->adapter_nr);
+		dev->file = open(filename, O_RDWR);
+		if (dev->file < 0) {
+			fprintf(stderr, "can't open %s\n", filename);
+			return 0;
+		}
+		if (ioctl(dev->file, I2C_FUNCS, &funcs) < 0 || (funcs & I2C_FUNC_I2C) == 0) {
+			fprintf(stderr, "%s does not support I2C_RDWR\n", filename);
+			close(dev->file);
+			dev->file = -1;
+			return 0;
+		}
+		break;
+	case U8X8_MSG_BYTE_SET_DC:
+		/* ignored for i2c */
+		break;
+	case U8X8_MSG_BYTE_START_TRANSFER:
+		dev->in_transfer = 1;
+		dev->transfer_start = dev->len;
+		dev->stats.transfers++;
+		break;
+	case U8X8_MSG_BYTE_END_TRANSFER:
+		u8x8_linux_i2c_end_transfer(dev);
+		if ( (dev->flags & U8X8_LINUX_I2C_DEFER) == 0 || dev->msg_cnt >= U8X8_LINUX_I2C_MAX_MSGS )
+			if ( u8x8_linux_i2c_flush_dev(dev) < 0 )
+				return 0;
+		break;
+	default:
+		return 0;
+	}
+	return 1;
+}
@@ -1,5 +1,5 @@
-#ifndef _LINUX_I2C_H
-#define _LINUX_I2C_H	1
+#ifndef _U8X8_LINUX_I2C_H
+#define _U8X8_LINUX_I2C_H	1
 
 
 
@@ -7,6 +7,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <linux/i2c-dev.h>
+#include <linux/i2c.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
@@ -22,4 +23,79 @@ uint8_t u8x8_byte_linux_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 uint8_t u8x8_linux_i2c_delay (u8x8_t * u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) ;
 
 
+/*
+  I2C_RDWR transport
+
+  u8x8_byte_linux_i2c_rdwr() sends each START/END transfer as one
+  struct i2c_msg of arbitrary length (no SMBus 32 byte limit). Transfers
+  are collected in a per device queue and written with a single
+  ioctl(I2C_RDWR), so a complete frame is sent with very few syscalls.
+
+  Usage:
+    u8x8_linux_i2c_t dev;
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_linux_i2c_rdwr, u8x8_linux_i2c_delay);
+    u8x8_linux_i2c_Attach(u8g2_GetU8x8(&u8g2), &dev, 1, U8X8_LINUX_I2C_DEFER|U8X8_LINUX_I2C_MERGE_DATA);
+    u8g2_InitDisplay(&u8g2);
+    ...
+    u8g2_SendBuffer(&u8g2);
+    u8x8_linux_i2c_Flush(u8g2_GetU8x8(&u8g2));
+
+  The i2c address is taken from u8x8_GetI2CAddress() (8 bit format, e.g. 0x78).
+*/
+
+/* size of the per device transfer buffer, one 128x64 frame plus protocol overhead fits easily */
+#ifndef U8X8_LINUX_I2C_BUF_SIZE
+#define U8X8_LINUX_I2C_BUF_SIZE 4096
+#endif
+
+/* max number of i2c messages per ioctl, limited by the kernel (I2C_RDWR_IOCTL_MAX_MSGS) */
+#ifndef U8X8_LINUX_I2C_MAX_MSGS
+#define U8X8_LINUX_I2C_MAX_MSGS 42
+#endif
+
+/* flags for u8x8_linux_i2c_Attach() */
+/* queue transfers until u8x8_linux_i2c_Flush(), a delay or a full queue, otherwise flush at each END_TRANSFER */
+#define U8X8_LINUX_I2C_DEFER 0x01
+/* append a data transfer (control byte 0x40, SSD13xx and compatible) to a directly preceding data transfer */
+#define U8X8_LINUX_I2C_MERGE_DATA 0x02
+
+typedef struct u8x8_linux_i2c_stats_struct u8x8_linux_i2c_stats_t;
+typedef struct u8x8_linux_i2c_struct u8x8_linux_i2c_t;
+
+struct u8x8_linux_i2c_stats_struct
+{
+  uint32_t bytes;		/* bytes written to the bus, including control bytes */
+  uint32_t transfers;	/* START/END transfers requested by u8x8 */
+  uint32_t msgs;		/* i2c messages actually sent, smaller than transfers if merged */
+  uint32_t ioctls;		/* number of I2C_RDWR syscalls */
+  uint32_t errors;		/* failed syscalls and buffer overflows */
+  uint64_t syscall_ns;	/* total time spent inside ioctl() */
+};
+
+struct u8x8_linux_i2c_struct
+{
+  u8x8_linux_i2c_t *next;
+  u8x8_t *u8x8;
+  int file;
+  int adapter_nr;
+  uint8_t flags;
+  uint8_t in_transfer;
+  uint16_t msg_cnt;
+  uint16_t len;				/* number of bytes used in buf */
+  uint16_t transfer_start;		/* start of the current transfer in buf */
+  uint16_t msg_start[U8X8_LINUX_I2C_MAX_MSGS];
+  uint16_t msg_len[U8X8_LINUX_I2C_MAX_MSGS];
+  uint8_t buf[U8X8_LINUX_I2C_BUF_SIZE];
+  u8x8_linux_i2c_stats_t stats;
+};
+
+void u8x8_linux_i2c_Attach(u8x8_t *u8x8, u8x8_linux_i2c_t *dev, int adapter_nr, uint8_t flags);
+void u8x8_linux_i2c_Detach(u8x8_t *u8x8);
+u8x8_linux_i2c_t *u8x8_linux_i2c_Get(u8x8_t *u8x8);
+int u8x8_linux_i2c_Flush(u8x8_t *u8x8);
+void u8x8_linux_i2c_ResetStats(u8x8_t *u8x8);
+void u8x8_linux_i2c_PrintStats(u8x8_t *u8x8, FILE *fp);
+uint8_t u8x8_byte_linux_i2c_rdwr(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+
 #endif // LINUXi2c
@@ -0,0 +1,71 @@
+/*
+  Record the bus traffic of a SSD1306 128x64 display (no hardware required),
+  print transfer statistics and replay the trace into a SSD1306 GRAM model.
+  The reconstructed image is written as PBM to stdout.
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 10
+
+u8g2_t u8g2;
+u8x8_byte_recorder_t recorder;
+uint8_t trace[64*1024];
+uint8_t gram[1024];
+
+uint32_t get_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000UL + ts.tv_nsec / 1000);
+}
+
+void out(const char *s)
+{
+  fputs(s, stdout);
+}
+
+int main(void)
+{
+  u8x8_trace_stats_t stats;
+  int i;
+  
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+  u8x8_ConnectByteRecorder(u8g2_GetU8x8(&u8g2), &recorder, trace, sizeof(trace), get_us);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8x8_ByteRecorderMarkFrame(u8g2_GetU8x8(&u8g2));
+  
+  for( i = 0; i < FRAMES; i++ )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    u8g2_DrawCircle(&u8g2, 14, 14, 12, U8G2_DRAW_ALL);
+    u8g2_DrawLine(&u8g2, 32, 2, 126, 26);
+    u8g2_DrawFrame(&u8g2, 0, 30, 128, 34);
+    u8g2_DrawBox(&u8g2, 2, 32, i*12, 30);
+    u8g2_SendBuffer(&u8g2);
+    u8x8_ByteRecorderMarkFrame(u8g2_GetU8x8(&u8g2));
+  }
+  
+  if ( u8x8_trace_Analyse(trace, recorder.len, &stats) == 0 )
+  {
+    fprintf(stderr, "invalid trace\n");
+    return 1;
+  }
+  
+  /* the first frame is the init sequence */
+  fprintf(stderr, "trace: %lu bytes, %lu records dropped\n", (unsigned long)recorder.len, (unsigned long)recorder.dropped);
+  fprintf(stderr, "frames: %lu, transfers: %lu, bytes: %lu\n", (unsigned long)stats.frames, (unsigned long)stats.transfers, (unsigned long)stats.bytes);
+  fprintf(stderr, "per frame: %lu transfers, %lu bytes\n", (unsigned long)(stats.transfers/stats.frames), (unsigned long)(stats.bytes/stats.frames));
+  fprintf(stderr, "cmd: %lu, data: %lu, ctrl: %lu\n", (unsigned long)stats.cmd_bytes, (unsigned long)stats.data_bytes, (unsigned long)stats.ctrl_bytes);
+  fprintf(stderr, "wire time @100kHz: %lu us, @400kHz: %lu us\n", 
+    (unsigned long)u8x8_trace_EstimateWireTime(&stats, U8X8_TRACE_BUS_I2C, 100000),
+    (unsigned long)u8x8_trace_EstimateWireTime(&stats, U8X8_TRACE_BUS_I2C, 400000));
+  
+  u8x8_trace_ReplaySSD1306(trace, recorder.len, gram);
+  u8x8_capture_write_pbm_pre(16, 8, out);
+  u8x8_capture_write_pbm_buffer(gram, 16, 8, u8x8_capture_get_pixel_1, out);
+  return 0;
+}
@@ -2910,6 +2910,7 @@ FILE *buf_code_fp;
 FILE *buf_header_fp;
 FILE *setup_code_fp;
 FILE *setup_header_fp;
+FILE *setup_list_fp;
 FILE *u8g2_cpp_header_fp;
 FILE *u8x8_cpp_header_fp;
 
@@ -3051,7 +3052,7 @@ void do_display_interface(int controller_idx, int display_idx, const char *postf
 
 /*===========================================*/
 
-void do_display(int controller_idx, int display_idx, const char *postfix)
+void do_display(int controller_idx, int display_idx, const char *postfix, int buf_len, int rows)
 {
   
   do_setup_prototype(setup_header_fp, controller_idx, display_idx, postfix);
@@ -3073,6 +3074,15 @@ void do_display(int controller_idx, int display_idx, const char *postfix)
   fprintf(setup_code_fp, "  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, %s, rotation);\n", controller_list[controller_idx].ll_hvline);
   fprintf(setup_code_fp, "}\n");
   
+  /* one line for each setup function in u8g2_d_list.txt, see u8g2_select.cmake */
+  fprintf(setup_list_fp, "%s ", get_setup_function_name(controller_idx, display_idx, postfix));
+  fprintf(setup_list_fp, "u8x8_d_%s_", strlowercase(controller_list[controller_idx].name));
+  fprintf(setup_list_fp, "%s ", strlowercase(controller_list[controller_idx].display_list[display_idx].name));
+  fprintf(setup_list_fp, "%s ", controller_list[controller_idx].cad);
+  fprintf(setup_list_fp, "u8g2_m_%d_%d_%s ", controller_list[controller_idx].tile_width, controller_list[controller_idx].tile_height, postfix);
+  fprintf(setup_list_fp, "%d %d ", buf_len, rows);
+  fprintf(setup_list_fp, "%s\n", controller_list[controller_idx].ll_hvline);
+  
   /* generate interfaces for this display */
   if ( controller_list[controller_idx].com & COM_4WSPI )
   {
@@ -3138,7 +3148,7 @@ void do_controller_buffer_code(int idx, const char *postfix, int buf_len, int ro
     fprintf(buf_code_fp, "  *page_cnt = %d;\n", rows);
     fprintf(buf_code_fp, "  return 0;\n");
     fprintf(buf_code_fp, "  #else\n");
-    fprintf(buf_code_fp, "  static uint8_t buf[%d];\n", buf_len);
+    fprintf(buf_code_fp, "  static uint8_t buf[%d] U8G2_BUFFER_ALIGNED;\n", buf_len);
     fprintf(buf_code_fp, "  *page_cnt = %d;\n", rows);
     fprintf(buf_code_fp, "  return buf;\n");
     fprintf(buf_code_fp, "  #endif\n");
@@ -3151,7 +3161,7 @@ void do_controller_buffer_code(int idx, const char *postfix, int buf_len, int ro
   fprintf(setup_code_fp, "/* %s %s */\n", controller_list[idx].name, postfix);
   while( controller_list[idx].display_list[display_idx].name != NULL )
   {
-    do_display(idx, display_idx, postfix);
+    do_display(idx, display_idx, postfix, buf_len, rows);
     display_idx++;
   }
   
@@ -3432,6 +3442,11 @@ int main(void)
   fprintf(setup_code_fp, "\n");
 
   setup_header_fp = fopen("u8g2_setup.h", "w");
+  
+  setup_list_fp = fopen("u8g2_d_list.txt", "w");
+  fprintf(setup_list_fp, "# u8g2_d_list.txt\n");
+  fprintf(setup_list_fp, "# generated code, codebuild, u8g2 project\n");
+  fprintf(setup_list_fp, "# setup function, display callback, cad callback, buffer function, buffer size, buffer tile rows, ll_hvline\n");
   //fprintf(setup_header_fp, "/* start of generated code, codebuild, u8g2 project */\n");
   
   u8g2_cpp_header_fp = fopen("U8g2lib.h", "w");
@@ -3485,6 +3500,8 @@ int main(void)
   //fprintf(setup_header_fp, "/* end of generated code */\n");
   fclose(setup_header_fp);
 
+  fclose(setup_list_fp);
+
   fclose(u8g2_cpp_header_fp);
 
   fclose(u8x8_cpp_header_fp);
@@ -3500,6 +3517,8 @@ int main(void)
   puts("generate u8g2_d_memory.c");
   system("cp u8g2_d_setup.c ../../csrc/.");
   puts("generate u8g2_d_setup.c");
+  system("cp u8g2_d_list.txt ../.");
+  puts("generate u8g2_d_list.txt");
 
   insert_into_file("../../csrc/u8g2.h", "u8g2_memory.h", "/* u8g2_d_memory.c generated code start */", "/* u8g2_d_memory.c generated code end */");
   insert_into_file("../../csrc/u8g2.h", "u8g2_setup.h", "/* u8g2_d_setup.c generated code start */", "/* u8g2_d_setup.c generated code end */");
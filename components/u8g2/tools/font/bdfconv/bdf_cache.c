@@ -0,0 +1,155 @@
+/*
+
+  bdf_cache.c
+
+  Incremental build cache for bdfconv.
+
+  The cache key is a 64 bit FNV-1a hash over everything which has an
+  influence on the generated output: The bdfconv version, the content of
+  the BDF file, the content of the map and utf8 files and all relevant
+  command line options. The generated files are stored as
+  <cache dir>/<16 digit hex key><suffix>.
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "bdf_font.h"
+
+#define BDF_CACHE_FNV_OFFSET 0xcbf29ce484222325ULL
+#define BDF_CACHE_FNV_PRIME 0x00000100000001b3ULL
+
+uint64_t bdf_cache_hash_init(void)
+{
+  return BDF_CACHE_FNV_OFFSET;
+}
+
+uint64_t bdf_cache_hash_data(uint64_t h, const uint8_t *data, size_t len)
+{
+  while( len > 0 )
+  {
+    h ^= *data++;
+    h *= BDF_CACHE_FNV_PRIME;
+    len--;
+  }
+  return h;
+}
+
+/* the terminating '\0' is included, so that "ab","c" differs from "a","bc" */
+uint64_t bdf_cache_hash_str(uint64_t h, const char *s)
+{
+  if ( s == NULL )
+    s = "";
+  return bdf_cache_hash_data(h, (const uint8_t *)s, strlen(s)+1);
+}
+
+uint64_t bdf_cache_hash_num(uint64_t h, unsigned long n)
+{
+  char buf[24];
+  sprintf(buf, "%lu", n);
+  return bdf_cache_hash_str(h, buf);
+}
+
+/* returns 0 if the file can not be read */
+int bdf_cache_hash_file(uint64_t *h, const char *filename)
+{
+  FILE *fp;
+  uint8_t buf[4096];
+  size_t len;
+
+  fp = fopen(filename, "rb");
+  if ( fp == NULL )
+    return 0;
+  for(;;)
+  {
+    len = fread(buf, 1, sizeof(buf), fp);
+    if ( len == 0 )
+      break;
+    *h = bdf_cache_hash_data(*h, buf, len);
+  }
+  fclose(fp);
+  /* separator between the file content and the next item */
+  *h = bdf_cache_hash_str(*h, "\001");
+  return 1;
+}
+
+static void bdf_cache_get_filename(char *buf, size_t size, const char *cache_dir, uint64_t key, const char *suffix)
+{
+  snprintf(buf, size, "%s/%016llx%s", cache_dir, (unsigned long long)key, suffix);
+}
+
+static int bdf_cache_copy_file(const char *src, const char *dest)
+{
+  FILE *in;
+  FILE *out;
+  uint8_t buf[4096];
+  size_t len;
+  int is_ok = 1;
+
+  in = fopen(src, "rb");
+  if ( in == NULL )
+    return 0;
+  out = fopen(dest, "wb");
+  if ( out == NULL )
+  {
+    fclose(in);
+    return 0;
+  }
+  for(;;)
+  {
+    len = fread(buf, 1, sizeof(buf), in);
+    if ( len == 0 )
+      break;
+    if ( fwrite(buf, 1, len, out) != len )
+    {
+      is_ok = 0;
+      break;
+    }
+  }
+  if ( ferror(in) )
+    is_ok = 0;
+  fclose(in);
+  if ( fclose(out) != 0 )
+    is_ok = 0;
+  return is_ok;
+}
+
+/* returns 1 if the cache entry exists */
+int bdf_cache_exists(const char *cache_dir, uint64_t key, const char *suffix)
+{
+  char name[1024];
+  bdf_cache_get_filename(name, sizeof(name), cache_dir, key, suffix);
+  return access(name, R_OK) == 0;
+}
+
+/* copy the cache entry to "filename", returns 0 if there is no such entry */
+int bdf_cache_get(const char *cache_dir, uint64_t key, const char *suffix, const char *filename)
+{
+  char name[1024];
+  bdf_cache_get_filename(name, sizeof(name), cache_dir, key, suffix);
+  return bdf_cache_copy_file(name, filename);
+}
+
+/*
+  store "filename" in the cache. The file is written to a temporary name first
+  and then renamed, so that a parallel bdfconv never sees a partial entry.
+*/
+int bdf_cache_put(const char *cache_dir, uint64_t key, const char *suffix, const char *filename)
+{
+  char name[1024];
+  char tmp_name[1100];
+  bdf_cache_get_filename(name, sizeof(name), cache_dir, key, suffix);
+  snprintf(tmp_name, sizeof(tmp_name), "%s.%ld.tmp", name, (long)getpid());
+  if ( bdf_cache_copy_file(filename, tmp_name) == 0 )
+  {
+    remove(tmp_name);
+    return 0;
+  }
+  if ( rename(tmp_name, name) != 0 )
+  {
+    remove(tmp_name);
+    return 0;
+  }
+  return 1;
+}
@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include "bdf_font.h"
 
 void bf_Error(bf_t *bf, char *fmt, ...)
@@ -38,6 +39,10 @@ bf_t *bf_Open(int is_verbose, int bbx_mode)
     bf->glyph_list = NULL;
     bf->glyph_cnt = 0;
     bf->glyph_max = 0;
+    bf->enc_first = NULL;
+    bf->enc_next = NULL;
+    bf->enc_first_size = 0;
+    bf->enc_glyph_cnt = -1;
     bf->str_font = NULL;		/* argument for FONT in bdf file */
     bf->str_copyright = NULL;	/* argument for COPYRIGHT in bdf file */
     bf->target_data = NULL;
@@ -64,9 +69,10 @@ void bf_Clear(bf_t *bf)
   int i;
   for( i = 0; i < bf->glyph_cnt; i++ )
   {
-    free( bf->glyph_list[i] );
+    bg_Close( bf->glyph_list[i] );
   }
   bf->glyph_cnt = 0;
+  bf->enc_glyph_cnt = -1;
   
   if ( bf->str_font != NULL )
     free(bf->str_font);
@@ -83,6 +89,10 @@ void bf_Close(bf_t *bf)
     free(bf->glyph_list);
   if ( bf->target_data != NULL )
     free(bf->target_data);
+  if ( bf->enc_first != NULL )
+    free(bf->enc_first);
+  if ( bf->enc_next != NULL )
+    free(bf->enc_next);
   bf->glyph_list = NULL;
   bf->glyph_max = 0;
   free(bf);
@@ -119,6 +129,7 @@ int bf_AddGlyph(bf_t *bf)
       return -1;
     bf->glyph_list[bf->glyph_cnt]->bf = bf;
     bf->glyph_cnt++;
+    bf->enc_glyph_cnt = -1;	/* encoding index is not valid any more */
     return bf->glyph_cnt-1;
 }
 
@@ -223,19 +234,100 @@ void bf_ShowAllGlyphs(bf_t *bf, bbx_t *bbx)
   }
 }
 
-int bf_GetIndexByEncoding(bf_t *bf, long encoding)
+/*
+  build a direct index from encoding to glyph position, returns 0 on memory error.
+  glyphs with the same encoding are linked in list order, so that the first
+  glyph found is the same as with a linear search.
+*/
+static int bf_build_encoding_index(bf_t *bf)
 {
   int i;
-  bg_t *bg;
+  long e;
+  long size = 0;
+  int *last;
+
   for( i = 0; i < bf->glyph_cnt; i++ )
   {
-    bg = bf->glyph_list[i];
-    if ( bg->encoding == encoding )
+    e = bf->glyph_list[i]->encoding;
+    if ( e >= 0 && e < BDF_ENCODING_INDEX_MAX && e >= size )
+      size = e+1;
+  }
+
+  if ( bf->enc_first != NULL )
+    free(bf->enc_first);
+  if ( bf->enc_next != NULL )
+    free(bf->enc_next);
+  bf->enc_first = (int *)malloc((size+1)*sizeof(int));
+  bf->enc_next = (int *)malloc((bf->glyph_cnt+1)*sizeof(int));
+  last = (int *)malloc((size+1)*sizeof(int));
+  if ( bf->enc_first == NULL || bf->enc_next == NULL || last == NULL )
+  {
+    if ( last != NULL )
+      free(last);
+    bf->enc_first_size = 0;
+    bf->enc_glyph_cnt = -1;
+    return 0;
+  }
+  
+  for( e = 0; e < size; e++ )
+    bf->enc_first[e] = -1;
+  for( i = 0; i < bf->glyph_cnt; i++ )
+  {
+    bf->enc_next[i] = -1;
+    e = bf->glyph_list[i]->encoding;
+    if ( e >= 0 && e < size )
+    {
+      if ( bf->enc_first[e] < 0 )
+	bf->enc_first[e] = i;
+      else
+	bf->enc_next[last[e]] = i;
+      last[e] = i;
+    }
+  }
+  free(last);
+  bf->enc_first_size = size;
+  bf->enc_glyph_cnt = bf->glyph_cnt;
+  return 1;
+}
+
+static int bf_is_encoding_index(bf_t *bf, long encoding)
+{
+  if ( encoding < 0 || encoding >= BDF_ENCODING_INDEX_MAX )
+    return 0;
+  if ( bf->enc_glyph_cnt != bf->glyph_cnt )
+    if ( bf_build_encoding_index(bf) == 0 )
+      return 0;
+  return 1;
+}
+
+static int bf_find_encoding(bf_t *bf, long encoding, int start)
+{
+  int i;
+  for( i = start; i < bf->glyph_cnt; i++ )
+  {
+    if ( bf->glyph_list[i]->encoding == encoding )
       return i;
   }
   return -1;
 }
 
+int bf_GetIndexByEncoding(bf_t *bf, long encoding)
+{
+  if ( bf_is_encoding_index(bf, encoding) == 0 )
+    return bf_find_encoding(bf, encoding, 0);
+  if ( encoding >= bf->enc_first_size )
+    return -1;
+  return bf->enc_first[encoding];
+}
+
+int bf_GetNextIndexByEncoding(bf_t *bf, int pos)
+{
+  long encoding = bf->glyph_list[pos]->encoding;
+  if ( bf_is_encoding_index(bf, encoding) == 0 )
+    return bf_find_encoding(bf, encoding, pos+1);
+  return bf->enc_next[pos];
+}
+
 void bf_CalculateMaxBBX(bf_t *bf)
 {
   int i;
@@ -703,6 +795,111 @@ int bf_WriteU8G2CByFilename(bf_t *bf, const char *filename, const char *fontname
 }
 
 
+/*
+  Copy the glyphs of a parsed font (bf_ParseFile()) into a new font object.
+  Must be called before bf_Map(), only the data from the BDF file is copied.
+  This allows to build several fonts from the same BDF file without parsing
+  the file again (bdfconv batch mode).
+*/
+bf_t *bf_Copy(const bf_t *src, int is_verbose, int bbx_mode)
+{
+  bf_t *bf;
+  bg_t *bg;
+  const bg_t *src_bg;
+  size_t bytes;
+  int i;
+
+  bf = bf_Open(is_verbose, bbx_mode);
+  if ( bf == NULL )
+    return NULL;
+  if ( src->str_font != NULL )
+    bf->str_font = strdup(src->str_font);
+  if ( src->str_copyright != NULL )
+    bf->str_copyright = strdup(src->str_copyright);
+
+  for( i = 0; i < src->glyph_cnt; i++ )
+  {
+    if ( bf_AddGlyph(bf) < 0 )
+    {
+      bf_Close(bf);
+      return NULL;
+    }
+    src_bg = src->glyph_list[i];
+    bg = bf->glyph_list[i];
+    bg->encoding = src_bg->encoding;
+    bg->map_to = src_bg->map_to;
+    bg->dwidth_x = src_bg->dwidth_x;
+    bg->dwidth_y = src_bg->dwidth_y;
+    bg->bbx = src_bg->bbx;
+    bg->shift_x = src_bg->shift_x;
+    bg->is_excluded_from_kerning = src_bg->is_excluded_from_kerning;
+    bg->bitmap_width = src_bg->bitmap_width;
+    bg->bitmap_height = src_bg->bitmap_height;
+    if ( src_bg->bitmap_data != NULL )
+    {
+      bytes = (size_t)src_bg->bitmap_width * (size_t)src_bg->bitmap_height;
+      if ( bg_SetBitmapSizeInBytes(bg, bytes) == 0 )
+      {
+	bf_Close(bf);
+	return NULL;
+      }
+      memcpy(bg->bitmap_data, src_bg->bitmap_data, bytes);
+    }
+  }
+  return bf;
+}
+
+/*
+  Apply the mapping and generate the target data for a parsed font.
+  xo, yo: offset for 8x8 fonts (font_format==2)
+*/
+int bf_Build(bf_t *bf, const char *map_str, const char *map_file_name, const char *utf8_file_name, int font_format, int xo, int yo, int th, int tv)
+{
+  bf->tile_h_size = th;
+  bf->tile_v_size = tv;
+  
+  if ( map_file_name[0] != '\0' ) 
+  {
+    bf_MapFile(bf, map_file_name);  // bdf_map.c
+  }
+  else
+  {
+    bf_Map(bf, map_str);     // bdf_map.c
+  }
+  if ( utf8_file_name[0] != '\0' )
+  {
+    bf_Utf8File(bf, utf8_file_name);
+  }
+  bf_CalculateSelectedNumberOfGlyphs(bf);
+  
+  bf_ReduceAllGlyph(bf);
+  bf_CalculateMaxBBX(bf);
+  //bf_ShowAllGlyphs(bf, &(bf->max));
+  bf_CalculateMinMaxDWidth(bf);
+  
+  /* issue 669 */
+  if ( bf->bbx_mode == BDF_BBX_MODE_MAX )
+    if ( bf->max.w < bf->dx_max )
+      bf->max.w = bf->dx_max;
+  
+  bf_CalculateMaxBitFieldSize(bf);  
+  
+  
+  if ( font_format == 0 || font_format == 1 )
+  {
+    bf_RLECompressAllGlyphs(bf);
+  }
+  else
+  {
+    bf_Generate8x8Font(bf, xo, yo);	/* bdf_8x8.c */
+  }
+  
+  if ( bf->bbx_mode != BDF_BBX_MODE_MINIMAL )
+    bf_ShowMonospaceStatistics(bf);	/* Show stats only for none minimal mode. For minimal mode it will always be zero */
+
+  return 1;
+}
+
 /*
   xo, yo: offset for 8x8 fonts (font_format==2)
   called from main()
@@ -714,51 +911,10 @@ bf_t *bf_OpenFromFile(const char *bdf_filename, int is_verbose, int bbx_mode, co
   bf = bf_Open(is_verbose, bbx_mode);
   if ( bf != NULL )
   {
-    bf->tile_h_size = th;
-    bf->tile_v_size = tv;
-    
     if ( bf_ParseFile(bf, bdf_filename) != 0 )
     {
-      if ( map_file_name[0] != '\0' ) 
-      {
-	bf_MapFile(bf, map_file_name);  // bdf_map.c
-      }
-      else
-      {
-	bf_Map(bf, map_str);     // bdf_map.c
-      }
-      if ( utf8_file_name[0] != '\0' )
-      {
-	bf_Utf8File(bf, utf8_file_name);
-      }
-      bf_CalculateSelectedNumberOfGlyphs(bf);
-      
-      bf_ReduceAllGlyph(bf);
-      bf_CalculateMaxBBX(bf);
-      //bf_ShowAllGlyphs(bf, &(bf->max));
-      bf_CalculateMinMaxDWidth(bf);
-      
-      /* issue 669 */
-      if ( bf->bbx_mode == BDF_BBX_MODE_MAX )
-	if ( bf->max.w < bf->dx_max )
-	  bf->max.w = bf->dx_max;
-      
-      bf_CalculateMaxBitFieldSize(bf);  
-      
-      
-      if ( font_format == 0 || font_format == 1 )
-      {
-	bf_RLECompressAllGlyphs(bf);
-      }
-      else
-      {
-	bf_Generate8x8Font(bf, xo, yo);	/* bdf_8x8.c */
-      }
-      
-      if ( bf->bbx_mode != BDF_BBX_MODE_MINIMAL )
-	bf_ShowMonospaceStatistics(bf);	/* Show stats only for none minimal mode. For minimal mode it will always be zero */
-    
-      return bf;
+      if ( bf_Build(bf, map_str, map_file_name, utf8_file_name, font_format, xo, yo, th, tv) != 0 )
+	return bf;
     }
     bf_Close(bf);
   }
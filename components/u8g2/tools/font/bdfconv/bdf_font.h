@@ -19,6 +19,9 @@
 #define BDF_BBX_MODE_M8 3
 #define BDF_BBX_MODE_5X7 4
 
+/* encodings below this value are stored in the encoding index, others are searched linearly */
+#define BDF_ENCODING_INDEX_MAX 0x110000L
+
 struct _bdf_font_struct
 {
   int is_verbose;
@@ -27,6 +30,12 @@ struct _bdf_font_struct
   int glyph_cnt;
   int glyph_max;
 
+  /* bf_GetIndexByEncoding: encoding index, built on demand, invalidated by bf_AddGlyph */
+  int *enc_first;		/* enc_first[encoding]: position of the first glyph with this encoding or -1 */
+  int *enc_next;		/* enc_next[pos]: position of the next glyph with the same encoding or -1 */
+  long enc_first_size;	/* number of entries in enc_first */
+  int enc_glyph_cnt;		/* number of glyphs in the index, -1 if the index is not valid */
+
   /* variables for the parser */
   char line_buf[BDF_LINE_LEN];
   int line_pos;
@@ -110,6 +119,8 @@ void bf_CalculateSelectedNumberOfGlyphs(bf_t *bf);
 void bf_ReduceAllGlyph(bf_t *bf);
 
 int bf_GetIndexByEncoding(bf_t *bf, long encoding);
+/* returns the position of the next glyph with the same encoding as the glyph at pos or -1 */
+int bf_GetNextIndexByEncoding(bf_t *bf, int pos);
 
 /* only shows glyphs, which will be mapped (call bf_Map() first) */
 void bf_ShowAllGlyphs(bf_t *bf, bbx_t *bbx);
@@ -123,6 +134,7 @@ void bf_CalculateMaxBBX(bf_t *bf);
 void bf_CalculateMinMaxDWidth(bf_t *bf);
 void bf_copy_bbx_and_update_shift(bf_t *bf, bbx_t *target_bbx, bg_t *bg);
 void bf_CalculateMaxBitFieldSize(bf_t *bf);
+extern int bf_rle_thread_cnt;
 void bf_RLECompressAllGlyphs(bf_t *bf);
 void bf_Generate8x8Font(bf_t *bf, int xo, int yo);
 
@@ -130,6 +142,8 @@ void bf_Generate8x8Font(bf_t *bf, int xo, int yo);
 int bf_WriteUCGCByFilename(bf_t *bf, const char *filename, const char *fontname, const char *indent);
 int bf_WriteU8G2CByFilename(bf_t *bf, const char *filename, const char *fontname, const char *indent);
 
+bf_t *bf_Copy(const bf_t *src, int is_verbose, int bbx_mode);
+int bf_Build(bf_t *bf, const char *map_str, const char *map_file_name, const char *utf8_file_name, int font_format, int xo, int yo, int th, int tv);
 bf_t *bf_OpenFromFile(const char *bdf_filename, int is_verbose, int bbx_mode, const char *map_str, const char *map_file_name, const char *utf8_file_name, int font_format, int xo, int yo, int th, int tv);
 
 
@@ -159,5 +173,15 @@ void tga_clear_pixel_intersection(void);
 unsigned bdf_calculate_kerning(uint8_t *font, uint16_t e1, uint16_t e2, uint8_t min_distance_in_per_cent_of_char_width);
 void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontname, uint8_t min_distance_in_per_cent_of_char_width);
 
+/* bdf_cache.c */
+uint64_t bdf_cache_hash_init(void);
+uint64_t bdf_cache_hash_data(uint64_t h, const uint8_t *data, size_t len);
+uint64_t bdf_cache_hash_str(uint64_t h, const char *s);
+uint64_t bdf_cache_hash_num(uint64_t h, unsigned long n);
+int bdf_cache_hash_file(uint64_t *h, const char *filename);
+int bdf_cache_exists(const char *cache_dir, uint64_t key, const char *suffix);
+int bdf_cache_get(const char *cache_dir, uint64_t key, const char *suffix, const char *filename);
+int bdf_cache_put(const char *cache_dir, uint64_t key, const char *suffix, const char *filename);
+
 
 #endif
@@ -6,6 +6,7 @@
 
 #include "bdf_font.h"
 #include <assert.h>
+#include <stdlib.h>
 
 #define BDF_KERNING_MAX (1024*60)
 
@@ -19,6 +20,17 @@ uint16_t bdf_second_table_cnt;
 uint16_t bdf_second_encoding_table[BDF_KERNING_MAX];
 uint8_t bdf_kerning_values[BDF_KERNING_MAX];
 
+/* all kerning pairs, sorted by bdf_sort_kerning_pairs() */
+typedef struct
+{
+  uint16_t first;
+  uint16_t second;
+  uint8_t kerning;
+} bdf_kerning_pair_t;
+
+static uint32_t bdf_kerning_pair_cnt;
+static bdf_kerning_pair_t bdf_kerning_pairs[BDF_KERNING_MAX];
+
 /*
 struct u8g2_kerning
 {
@@ -73,6 +85,32 @@ static void bdf_write_uint8_array(FILE *fp, const char *pre, const char *post, u
 }
 
 
+/*
+  write a sorted and indexed table for u8g2_DrawExtUTF8(), see U8G2_KERNING_TABLE_INDEXED in u8g2.h
+  the first table contains the terminating 0x0ffff entry, so the index part has bdf_first_table_cnt entries
+*/
+static void bdf_write_indexed_kerning_table(FILE *fp, const char *name)
+{
+  uint16_t i;
+  
+  fprintf(fp, "/* %s_kt for u8g2_DrawExtUTF8(), Size: %u Bytes */\n", name, (bdf_first_table_cnt*2 + bdf_second_table_cnt*2 + 5)*2);
+  fprintf(fp, "const uint16_t %s_kt[] = {\n", name);
+  fprintf(fp, "  U8G2_KERNING_TABLE_INDEXED, %u,\n", bdf_first_table_cnt-1);
+  for( i = 0; i < bdf_first_table_cnt; i++ )
+  {
+    fprintf(fp, "%s%u, %u,", (i % 8 == 0) ? "  " : " ", bdf_first_encoding_table[i], bdf_index_to_second_table[i]);
+    if ( i % 8 == 7 || i+1 == bdf_first_table_cnt )
+      fprintf(fp, "\n");
+  }
+  for( i = 0; i < bdf_second_table_cnt; i++ )
+  {
+    fprintf(fp, "%s%u, %u,", (i % 8 == 0) ? "  " : " ", bdf_second_encoding_table[i], bdf_kerning_values[i]);
+    if ( i % 8 == 7 || i+1 == bdf_second_table_cnt )
+      fprintf(fp, "\n");
+  }
+  fprintf(fp, "  0xffff, 0xffff, 0xffff};\n\n");
+}
+
 void bdf_write_kerning_file(const char *kernfile, const char *name)
 {
   FILE *fp;
@@ -90,7 +128,9 @@ void bdf_write_kerning_file(const char *kernfile, const char *name)
   fprintf(fp, "  %s_%s,\n", name, "first_encoding_table");
   fprintf(fp, "  %s_%s,\n", name, "index_to_second_table");
   fprintf(fp, "  %s_%s,\n", name, "second_encoding_table");
-  fprintf(fp, "  %s_%s};\n\n", name, "kerning_values");
+  fprintf(fp, "  %s_%s,\n", name, "kerning_values");
+  fprintf(fp, "  U8G2_KERNING_SORTED};\n\n");
+  bdf_write_indexed_kerning_table(fp, name);
   fclose(fp);
 }
 
@@ -156,21 +196,57 @@ unsigned bdf_calculate_kerning(uint8_t *font, uint16_t e1, uint16_t e2, uint8_t
   return kerning;
 }
 
+static int bdf_kerning_pair_compare(const void *a, const void *b)
+{
+  const bdf_kerning_pair_t *pa = (const bdf_kerning_pair_t *)a;
+  const bdf_kerning_pair_t *pb = (const bdf_kerning_pair_t *)b;
+  if ( pa->first != pb->first )
+    return (int)pa->first - (int)pb->first;
+  return (int)pa->second - (int)pb->second;
+}
+
+/*
+  the glyph list is not sorted by encoding (e.g. because of the mapping), so sort all pairs first, 
+  then build the first and second encoding tables
+*/
+static void bdf_build_kerning_tables(void)
+{
+  uint32_t i;
+  
+  qsort(bdf_kerning_pairs, bdf_kerning_pair_cnt, sizeof(bdf_kerning_pair_t), bdf_kerning_pair_compare);
+  
+  bdf_first_table_cnt = 0;
+  bdf_second_table_cnt = 0;
+  for( i = 0; i < bdf_kerning_pair_cnt; i++ )
+  {
+    if ( i == 0 || bdf_kerning_pairs[i].first != bdf_kerning_pairs[i-1].first )
+    {
+      bdf_first_encoding_table[bdf_first_table_cnt] = bdf_kerning_pairs[i].first;
+      bdf_index_to_second_table[bdf_first_table_cnt]  = bdf_second_table_cnt;
+      bdf_first_table_cnt++;
+    }
+    bdf_second_encoding_table[bdf_second_table_cnt] = bdf_kerning_pairs[i].second;
+    bdf_kerning_values[bdf_second_table_cnt] = bdf_kerning_pairs[i].kerning;
+    bdf_second_table_cnt++;
+  }
+  
+  /* add a final entry for more easier calculation in u8g2 */
+  bdf_first_encoding_table[bdf_first_table_cnt] = 0x0ffff;
+  bdf_index_to_second_table[bdf_first_table_cnt]  = bdf_second_table_cnt;
+  bdf_first_table_cnt++;
+}
+
 void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontname, uint8_t min_distance_in_per_cent_of_char_width)
 {
   int first, second;
   bg_t *bg_first;
   bg_t *bg_second;
   uint8_t kerning;
-  int is_first_encoding_added;
 
-  
-  bdf_first_table_cnt = 0;
-  bdf_second_table_cnt = 0;
+  bdf_kerning_pair_cnt = 0;
   
   for( first= 0; first < bf->glyph_cnt; first++ )
   {
-    is_first_encoding_added = 0;
     bg_first = bf->glyph_list[first];
     if ( bg_first->target_data != NULL && bg_first->is_excluded_from_kerning == 0 )
     {
@@ -182,36 +258,23 @@ void bdf_calculate_all_kerning(bf_t *bf, const char *filename, const char *fontn
           kerning = bdf_calculate_kerning(bf->target_data, bg_first->encoding, bg_second->encoding, min_distance_in_per_cent_of_char_width);
 	  if ( kerning > 1 )
 	  {
-	    if ( is_first_encoding_added == 0 )
+	    /* one entry is required for the final 0x0ffff entry of the first table */
+	    if ( bdf_kerning_pair_cnt+1 >= BDF_KERNING_MAX )
 	    {
-	      bdf_first_encoding_table[bdf_first_table_cnt] = bg_first->encoding;
-	      bdf_index_to_second_table[bdf_first_table_cnt]  = bdf_second_table_cnt;
-	      bdf_first_table_cnt++;
-	      if (bdf_first_table_cnt > BDF_KERNING_MAX)
-	      {
-		      fprintf(stderr, "Kerning calculation aborted: bdf_first_table_cnt > BDF_KERNING_MAX\n");
-		      return;
-	      }
-	      is_first_encoding_added = 1;
-	    }
-	    bdf_second_encoding_table[bdf_second_table_cnt] = bg_second->encoding;
-	    bdf_kerning_values[bdf_second_table_cnt] = kerning;
-	    bdf_second_table_cnt++;
-	    if (bdf_second_table_cnt > BDF_KERNING_MAX)
-	    {
-		      fprintf(stderr, "Kerning calculation aborted: bdf_second_table_cnt > BDF_KERNING_MAX\n");
+		      fprintf(stderr, "Kerning calculation aborted: more than BDF_KERNING_MAX kerning pairs\n");
 		      return;
 	    }
+	    bdf_kerning_pairs[bdf_kerning_pair_cnt].first = bg_first->encoding;
+	    bdf_kerning_pairs[bdf_kerning_pair_cnt].second = bg_second->encoding;
+	    bdf_kerning_pairs[bdf_kerning_pair_cnt].kerning = kerning;
+	    bdf_kerning_pair_cnt++;
 	  }
         }
       }
     }
   }
-  /* add a final entry for more easier calculation in u8g2 */
-  bdf_first_encoding_table[bdf_first_table_cnt] = 0x0ffff;
-  bdf_index_to_second_table[bdf_first_table_cnt]  = bdf_second_table_cnt;
-  bdf_first_table_cnt++;
   
+  bdf_build_kerning_tables();
   bdf_write_kerning_file(filename, fontname);
 }
 
@@ -215,9 +215,29 @@ static void map_cmd(const char **s)
   }
 }
 
+static void bf_map_glyph(bg_t *bg)
+{
+  if ( is_kern_exclude != 0 )
+  {
+	  bg->is_excluded_from_kerning = 1;
+  }
+  else
+  {
+	  if ( is_exclude != 0 )
+	  {
+	    bg->map_to = -1;
+	  }
+	  else
+	  {
+	    bg->map_to = bg->encoding - range_from + map_to;
+	  }
+  }
+}
+
 void bf_map_cmd(bf_t *bf, const char **s)
 {
   int i;
+  long e;
   bg_t *bg;
   static int is_log_disabled_for_single_glyphs = 0;
   
@@ -238,26 +258,20 @@ void bf_map_cmd(bf_t *bf, const char **s)
   }
   
   
-  for( i = 0; i < bf->glyph_cnt; i++ )
+  if ( range_from >= 0 && range_to < BDF_ENCODING_INDEX_MAX && range_to - range_from < bf->glyph_cnt )
   {
-    bg = bf->glyph_list[i];
-    if ( bg->encoding >= range_from && bg->encoding <= range_to )
+    /* small range: use the encoding index instead of checking all glyphs */
+    for( e = range_from; e <= range_to; e++ )
+      for( i = bf_GetIndexByEncoding(bf, e); i >= 0; i = bf_GetNextIndexByEncoding(bf, i) )
+	bf_map_glyph(bf->glyph_list[i]);
+  }
+  else
+  {
+    for( i = 0; i < bf->glyph_cnt; i++ )
     {
-      if ( is_kern_exclude != 0 )
-      {
-	      bg->is_excluded_from_kerning = 1;
-      }
-      else
-      {
-	      if ( is_exclude != 0 )
-	      {
-		bg->map_to = -1;
-	      }
-	      else
-	      {
-		bg->map_to = bg->encoding - range_from + map_to;
-	      }
-      }
+      bg = bf->glyph_list[i];
+      if ( bg->encoding >= range_from && bg->encoding <= range_to )
+	bf_map_glyph(bg);
     }
   }
   
@@ -387,16 +401,14 @@ int bf_Utf8File(bf_t *bf, const char *utf8_file_name) {
     }
     if (more_bytes == 0) {
       /* find glyph in font */
-      for (i = 0; i < bf->glyph_cnt; i++) {
+      i = bf_GetIndexByEncoding(bf, code);
+      if (i >= 0) {
         bg = bf->glyph_list[i];
-        if (bg->encoding == code) {
-          if (utf8_verbose)
-            printf("glyph found: 0x%X\r\n", code);
-          bg->map_to = bg->encoding;
-          break;
-        }
+        if (utf8_verbose)
+          printf("glyph found: 0x%X\r\n", code);
+        bg->map_to = bg->encoding;
       }
-      if (utf8_verbose && (i == bf->glyph_cnt))
+      if (utf8_verbose && (i < 0))
         printf("glyph not found: 0x%X\r\n", code);
     }
   }
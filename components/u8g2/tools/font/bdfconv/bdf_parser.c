@@ -5,6 +5,18 @@
 #include <string.h>
 #include "bdf_font.h"
 
+/* map the BDF file into memory instead of reading it with fgets() */
+#if !defined(BDF_PARSER_MMAP) && !defined(_WIN32)
+#define BDF_PARSER_MMAP
+#endif
+
+#ifdef BDF_PARSER_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 static int bf_curr(bf_t * bf)
 {
   if ( bf->line_pos >= BDF_LINE_LEN )
@@ -461,9 +473,79 @@ static int bf_parse_file(bf_t *bf)
   return 1;
 }
 
+#ifdef BDF_PARSER_MMAP
+/*
+  parse a memory mapped BDF file. The lines are copied into line_buf
+  with the same splitting rules as fgets(), so the line parser and the
+  line numbers in error messages do not change.
+*/
+static int bf_parse_mem(bf_t *bf, const char *data, size_t size)
+{
+  long line_cnt = 0;
+  size_t pos = 0;
+  size_t len;
+  const char *eol;
+  
+  bf->is_bitmap_parsing = 0;
+  while( pos < size )
+  {
+    line_cnt++;
+    len = size - pos;
+    if ( len > BDF_LINE_LEN-1 )
+      len = BDF_LINE_LEN-1;
+    eol = memchr(data+pos, '\n', len);
+    if ( eol != NULL )
+      len = eol - (data+pos) + 1;
+    memcpy(bf->line_buf, data+pos, len);
+    bf->line_buf[len] = '\0';
+    pos += len;
+    if ( bf_parse_line(bf) == 0 )
+    {
+      bf_Error(bf, "perse error in line %ld", line_cnt);
+      return 0;
+    }    
+  }
+  return 1;
+}
+
+/* returns -1 if the file can not be mapped, the caller should use stdio then */
+static int bf_parse_mmap(bf_t *bf, const char *name)
+{
+  int fd;
+  struct stat st;
+  void *data;
+  int r;
+
+  fd = open(name, O_RDONLY);
+  if ( fd < 0 )
+    return -1;
+  if ( fstat(fd, &st) != 0 || st.st_size <= 0 )
+  {
+    close(fd);
+    return -1;
+  }
+  data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( data == MAP_FAILED )
+    return -1;
+  madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+  r = bf_parse_mem(bf, (const char *)data, (size_t)st.st_size);
+  munmap(data, (size_t)st.st_size);
+  return r;
+}
+#endif
+
 int bf_ParseFile(bf_t *bf, const char *name)
 {
   int r;
+#ifdef BDF_PARSER_MMAP
+  r = bf_parse_mmap(bf, name);
+  if ( r >= 0 )
+  {
+    bf_Log(bf, "Parse File %s: %d glyph(s) found", name, bf->glyph_cnt);
+    return r;
+  }
+#endif
   bf->fp = fopen(name, "r");
   if ( bf->fp == NULL )
   {
@@ -475,4 +557,3 @@ int bf_ParseFile(bf_t *bf, const char *name)
   bf_Log(bf, "Parse File %s: %d glyph(s) found", name, bf->glyph_cnt);
   return r;
 }
-
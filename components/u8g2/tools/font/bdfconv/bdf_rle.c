@@ -63,6 +63,10 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #include "bdf_font.h"
 
 #ifdef OLD_CODE
@@ -369,7 +373,7 @@ int bg_rle_compress(bg_t *bg, bbx_t *bbx, unsigned rle_bits_per_0, unsigned rle_
   int bd_max_len;
   int bd_chg_cnt;
   
-  static int bd_list[1024*2];
+  int bd_list[1024*2];		/* not static: bg_rle_compress is called by several threads */
 
   if ( bbx == NULL )
     bbx = &(bg->bbx);
@@ -607,6 +611,127 @@ unsigned long bf_RLECompressAllGlyphsWithFieldSize(bf_t *bf, int rle_0, int rle_
 }
 
 
+/*
+  Parallel RLE compression
+
+  All glyphs are distributed to a pool of worker threads. Each glyph is compressed by exactly one thread,
+  so the result is identical to the single threaded version. During the parameter search, each thread
+  compresses its glyphs with all (rle_0, rle_1) pairs and sums up the bit sizes.
+*/
+
+#define BDF_RLE_0_MIN 2
+#define BDF_RLE_0_CNT 7
+#define BDF_RLE_1_MIN 2
+#define BDF_RLE_1_CNT 5
+#define BDF_RLE_MAX_THREADS 64
+#define BDF_RLE_GLYPHS_PER_TASK 32
+
+/* number of worker threads, 0: number of cores, assigned by option -j */
+int bf_rle_thread_cnt = 0;
+
+struct bf_rle_job_struct
+{
+  bf_t *bf;
+  int is_search;		/* 1: sum up the size for all rle_0/rle_1 pairs, 0: compress with rle_0/rle_1 */
+  int rle_0;
+  int rle_1;
+  int next_glyph;
+  pthread_mutex_t mutex;
+  unsigned long total_bits[BDF_RLE_0_CNT][BDF_RLE_1_CNT];
+};
+typedef struct bf_rle_job_struct bf_rle_job_t;
+
+static int bf_rle_get_thread_cnt(void)
+{
+  long n = bf_rle_thread_cnt;
+#ifdef _SC_NPROCESSORS_ONLN
+  if ( n <= 0 )
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  if ( n <= 0 )
+    n = 1;
+  if ( n > BDF_RLE_MAX_THREADS )
+    n = BDF_RLE_MAX_THREADS;
+  return (int)n;
+}
+
+static double bf_rle_get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec/1000000000.0;
+}
+
+static void *bf_rle_worker(void *arg)
+{
+  bf_rle_job_t *job = (bf_rle_job_t *)arg;
+  bf_t *bf = job->bf;
+  bg_t *bg;
+  bbx_t local_bbx;
+  unsigned long total_bits[BDF_RLE_0_CNT][BDF_RLE_1_CNT];
+  int start, i, a, b;
+  
+  for( a = 0; a < BDF_RLE_0_CNT; a++ )
+    for( b = 0; b < BDF_RLE_1_CNT; b++ )
+      total_bits[a][b] = 0;
+  
+  for(;;)
+  {
+    pthread_mutex_lock(&(job->mutex));
+    start = job->next_glyph;
+    job->next_glyph += BDF_RLE_GLYPHS_PER_TASK;
+    pthread_mutex_unlock(&(job->mutex));
+    if ( start >= bf->glyph_cnt )
+      break;
+    for( i = start; i < start + BDF_RLE_GLYPHS_PER_TASK && i < bf->glyph_cnt; i++ )
+    {
+      bg = bf->glyph_list[i];
+      if ( bg->map_to < 0 )
+        continue;
+      bf_copy_bbx_and_update_shift(bf, &local_bbx, bg);
+      if ( job->is_search )
+      {
+        /* same order as the single threaded search, so the last compression is done with the biggest values */
+        for( a = 0; a < BDF_RLE_0_CNT; a++ )
+          for( b = 0; b < BDF_RLE_1_CNT; b++ )
+          {
+            bg_rle_compress(bg, &local_bbx, a+BDF_RLE_0_MIN, b+BDF_RLE_1_MIN, 0); 
+            total_bits[a][b] += bg->target_cnt*8+bg->target_bit_pos;
+          }
+      }
+      else
+      {
+        bg_rle_compress(bg, &local_bbx, job->rle_0, job->rle_1, 0); 
+      }
+    }
+  }
+  
+  pthread_mutex_lock(&(job->mutex));
+  for( a = 0; a < BDF_RLE_0_CNT; a++ )
+    for( b = 0; b < BDF_RLE_1_CNT; b++ )
+      job->total_bits[a][b] += total_bits[a][b];
+  pthread_mutex_unlock(&(job->mutex));
+  return NULL;
+}
+
+/* run the job with the calling thread and thread_cnt-1 additional threads */
+static void bf_rle_run_job(bf_rle_job_t *job, int thread_cnt)
+{
+  pthread_t threads[BDF_RLE_MAX_THREADS];
+  int i, cnt = 0;
+  
+  job->next_glyph = 0;
+  for( i = 1; i < thread_cnt; i++ )
+  {
+    if ( pthread_create(threads+cnt, NULL, bf_rle_worker, job) != 0 )
+      break;	/* continue with less threads */
+    cnt++;
+  }
+  bf_rle_worker(job);
+  for( i = 0; i < cnt; i++ )
+    pthread_join(threads[i], NULL);
+}
+
 unsigned bf_RLE_get_glyph_data(bf_t *bf, uint8_t encoding)
 {
   uint8_t *font = bf->target_data;
@@ -656,6 +781,10 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
   unsigned unicode_lookup_table_glyph_cnt;
   uint32_t unicode_glyph_cnt = 0;
   
+  bf_rle_job_t job;
+  int thread_cnt;
+  double t0, t1, t2;
+  
   idx_cap_a_ascent = 0;
   idx_cap_a = bf_GetIndexByEncoding(bf, 'A');
   if ( idx_cap_a >= 0 )
@@ -695,11 +824,19 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
   }
 
   
-  for( rle_0 = 2; rle_0 < 9; rle_0++ )
+  thread_cnt = bf_rle_get_thread_cnt();
+  memset(&job, 0, sizeof(job));
+  job.bf = bf;
+  pthread_mutex_init(&(job.mutex), NULL);
+  
+  t0 = bf_rle_get_time();
+  job.is_search = 1;
+  bf_rle_run_job(&job, thread_cnt);
+  for( rle_0 = BDF_RLE_0_MIN; rle_0 < BDF_RLE_0_MIN+BDF_RLE_0_CNT; rle_0++ )
   {
-    for( rle_1 = 2; rle_1 < 7; rle_1++ )
+    for( rle_1 = BDF_RLE_1_MIN; rle_1 < BDF_RLE_1_MIN+BDF_RLE_1_CNT; rle_1++ )
     {
-      total_bits = bf_RLECompressAllGlyphsWithFieldSize(bf, rle_0, rle_1, 0);
+      total_bits = job.total_bits[rle_0-BDF_RLE_0_MIN][rle_1-BDF_RLE_1_MIN];
       if ( min_total_bits > total_bits )
       {
 	min_total_bits = total_bits;
@@ -710,7 +847,15 @@ void bf_RLECompressAllGlyphs(bf_t *bf)
     }
   }
   bf_Log(bf, "RLE Compress: best zero bits %d, one bits %d, total bit size %lu", best_rle_0, best_rle_1, min_total_bits);
-  bf_RLECompressAllGlyphsWithFieldSize(bf, best_rle_0, best_rle_1, 0);
+  
+  t1 = bf_rle_get_time();
+  job.is_search = 0;
+  job.rle_0 = best_rle_0;
+  job.rle_1 = best_rle_1;
+  bf_rle_run_job(&job, thread_cnt);
+  t2 = bf_rle_get_time();
+  pthread_mutex_destroy(&(job.mutex));
+  bf_Log(bf, "RLE Compress: threads %d, parameter search %.3f sec, compression %.3f sec", thread_cnt, t1-t0, t2-t1);
 
 
   bf_ClearTargetData(bf);
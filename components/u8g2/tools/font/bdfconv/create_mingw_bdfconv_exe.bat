@@ -1,4 +1,4 @@
-gcc -g bdf*.c fd.c main.c -o bdfconv.exe
+gcc -g bdf*.c fd.c main.c -lpthread -o bdfconv.exe
 dir bdfconv.exe
 
 
@@ -150,6 +150,9 @@ void help(void)
   printf("-a          Overview picture: Additional font information (background, orange&blue dot)\n");
   printf("-t          Overview picture: Test string (Woven silk pyjamas exchanged for blue quartz.)\n");
   printf("-r          Runtime test\n");
+  printf("-j <n>      Number of threads for the RLE compression (default: number of cores)\n");
+  printf("-C <dir>    Build cache: Reuse the output files from <dir>, if the BDF file, the map files and options are unchanged\n");
+  printf("-B <file>   Batch mode: Each line of <file> contains the options for one font, other options are applied to all fonts\n");
   printf("\n");
 
   printf("map := <mapcmd> { \",\" <mapcmd> }\n");
@@ -193,6 +196,7 @@ unsigned long xoffset = 0;
 unsigned long yoffset = 0;
 unsigned long tile_h_size = 1;
 unsigned long tile_v_size = 1;
+unsigned long thread_cnt = 0;
 int font_picture_extra_info = 0;
 int font_picture_test_string = 0;
 int runtime_test = 0;
@@ -332,38 +336,54 @@ unsigned tga_draw_font(unsigned y, const char *fontname, bf_t *bf_desc_font, bf_
   return y;
 }
 
-
 /*================================================*/
-/* main */
+/* options */
+
+char *bdf_filename = NULL;
+int is_verbose = 0;
+char *map_str ="*";
+char *map_filename ="";
+char *utf8_filename = "";
+char *desc_font_str = "";
+char *cache_dir = NULL;
+char *batch_filename = NULL;
+
+/* restore the default values before each conversion in batch mode */
+void set_default_options(void)
+{
+  left_margin = 1;
+  build_bbx_mode = 0;
+  font_format = 0;
+  min_distance_in_per_cent_of_char_width = 25;
+  cmdline_glyphs_per_line = 16;
+  xoffset = 0;
+  yoffset = 0;
+  tile_h_size = 1;
+  tile_v_size = 1;
+  font_picture_extra_info = 0;
+  font_picture_test_string = 0;
+  runtime_test = 0;
+  c_filename = NULL;
+  k_filename = NULL;
+  target_fontname = "bdf_font";
+  bdf_filename = NULL;
+  is_verbose = 0;
+  map_str ="*";
+  map_filename ="";
+  utf8_filename = "";
+  desc_font_str = "";
+}
 
-int main(int argc, char **argv)
+/* returns 0 if help has been requested */
+int parse_args(char **argv)
 {
-  bf_t *bf_desc_font;
-  bf_t *bf;
-  char *bdf_filename = NULL;
-  int is_verbose = 0;
-  char *map_str ="*";
-  char *map_filename ="";
-  char *utf8_filename = "";
-  char *desc_font_str = "";
-  unsigned y;
-  
-  argv++;
-  /*
-  if ( *argv == NULL )
-  {
-    help();
-    exit(1);
-  }
-  */
   for(;;)
   {
     if ( *argv == NULL )
       break;
     if ( is_arg(&argv, 'h') != 0 )
     {
-      help();
-      exit(1);
+      return 0;
     }
     else if ( is_arg(&argv, 'v') != 0 )
     {
@@ -387,6 +407,10 @@ int main(int argc, char **argv)
     {
       runtime_test = 1;
     }    
+    else if ( get_num_arg(&argv, 'j', &thread_cnt) != 0 )
+    {
+      bf_rle_thread_cnt = thread_cnt;
+    }
     else if ( get_num_arg(&argv, 'g', &cmdline_glyphs_per_line) != 0 )
     {
     }
@@ -429,26 +453,173 @@ int main(int argc, char **argv)
     else if ( get_str_arg(&argv, 'u', &utf8_filename) != 0 )
     {
     }
+    else if ( get_str_arg(&argv, 'C', &cache_dir) != 0 )
+    {
+    }
+    else if ( get_str_arg(&argv, 'B', &batch_filename) != 0 )
+    {
+    }
     else
     {
       bdf_filename = *argv;
       argv++;
     }
   }
-  
-  if ( bdf_filename  == NULL )
+  return 1;
+}
+
+/*================================================*/
+/* parsed BDF files, shared between the fonts of a batch */
+
+#define SOURCE_MAX 64
+
+int is_batch_mode = 0;
+char *source_name[SOURCE_MAX];
+bf_t *source_bf[SOURCE_MAX];
+int source_cnt = 0;
+
+/* returns the parsed BDF file, or NULL if the file can not be read */
+bf_t *get_source(const char *filename)
+{
+  int i;
+  bf_t *bf;
+  for( i = 0; i < source_cnt; i++ )
+    if ( strcmp(source_name[i], filename) == 0 )
+      return source_bf[i];
+  if ( source_cnt >= SOURCE_MAX )
+    return NULL;
+  bf = bf_Open(0, BDF_BBX_MODE_MINIMAL);
+  if ( bf == NULL )
+    return NULL;
+  if ( bf_ParseFile(bf, filename) == 0 )
   {
-    help();
-    exit(1);
+    bf_Close(bf);
+    return NULL;
   }
+  source_name[source_cnt] = strdup(filename);
+  source_bf[source_cnt] = bf;
+  source_cnt++;
+  return bf;
+}
 
+void clear_sources(void)
+{
+  while( source_cnt > 0 )
+  {
+    source_cnt--;
+    free(source_name[source_cnt]);
+    bf_Close(source_bf[source_cnt]);
+  }
+}
+
+/* in batch mode, reuse the already parsed BDF file */
+bf_t *open_font(const char *filename, int is_verbose, int bbx_mode, const char *map_str, const char *map_file_name, const char *utf8_file_name, int font_format, int xo, int yo, int th, int tv)
+{
+  bf_t *src;
+  bf_t *bf;
+  if ( is_batch_mode != 0 )
+  {
+    src = get_source(filename);
+    if ( src != NULL )
+    {
+      bf = bf_Copy(src, is_verbose, bbx_mode);
+      if ( bf == NULL )
+	return NULL;
+      bf_Build(bf, map_str, map_file_name, utf8_file_name, font_format, xo, yo, th, tv);
+      return bf;
+    }
+  }
+  return bf_OpenFromFile(filename, is_verbose, bbx_mode, map_str, map_file_name, utf8_file_name, font_format, xo, yo, th, tv);
+}
+
+/*================================================*/
+/* build cache */
+
+/* 
+  increment this number if the format of the cache or the generated output of bdfconv changes,
+  so that old cache entries are not used any more
+*/
+#define BDFCONV_CACHE_VERSION 1
+
+/* returns 0 if one of the input files can not be read */
+int get_cache_key(uint64_t *key)
+{
+  uint64_t h = bdf_cache_hash_init();
+  h = bdf_cache_hash_str(h, "bdfconv");
+  h = bdf_cache_hash_num(h, BDFCONV_CACHE_VERSION);
+  if ( bdf_cache_hash_file(&h, bdf_filename) == 0 )
+    return 0;
+  if ( map_filename[0] != '\0' )
+    if ( bdf_cache_hash_file(&h, map_filename) == 0 )
+      return 0;
+  if ( utf8_filename[0] != '\0' )
+    if ( bdf_cache_hash_file(&h, utf8_filename) == 0 )
+      return 0;
+  h = bdf_cache_hash_str(h, map_filename[0] != '\0' ? "" : map_str);
+  h = bdf_cache_hash_num(h, build_bbx_mode);
+  h = bdf_cache_hash_num(h, font_format);
+  h = bdf_cache_hash_num(h, xoffset);
+  h = bdf_cache_hash_num(h, yoffset);
+  h = bdf_cache_hash_num(h, tile_h_size);
+  h = bdf_cache_hash_num(h, tile_v_size);
+  h = bdf_cache_hash_num(h, min_distance_in_per_cent_of_char_width);
+  h = bdf_cache_hash_str(h, target_fontname);
+  *key = h;
+  return 1;
+}
+
+/* copy the generated files from the cache, returns 0 if they are not available */
+int get_from_cache(uint64_t key)
+{
+  if ( c_filename != NULL && bdf_cache_exists(cache_dir, key, ".c") == 0 )
+    return 0;
+  if ( k_filename != NULL && bdf_cache_exists(cache_dir, key, "_k.c") == 0 )
+    return 0;
+  if ( c_filename != NULL && bdf_cache_get(cache_dir, key, ".c", c_filename) == 0 )
+    return 0;
+  if ( k_filename != NULL && bdf_cache_get(cache_dir, key, "_k.c", k_filename) == 0 )
+    return 0;
+  return 1;
+}
+
+void put_to_cache(uint64_t key)
+{
+  if ( c_filename != NULL )
+    bdf_cache_put(cache_dir, key, ".c", c_filename);
+  if ( k_filename != NULL )
+    bdf_cache_put(cache_dir, key, "_k.c", k_filename);
+}
+
+/*================================================*/
+/* convert a single font, returns 0 on error */
+
+int convert(void)
+{
+  bf_t *bf_desc_font;
+  bf_t *bf;
+  unsigned y;
+  uint64_t cache_key;
+  int is_cache = 0;
+  
+  /* the overview picture and the runtime test require the font object, so do not use the cache */
+  if ( cache_dir != NULL && desc_font_str[0] == '\0' && runtime_test == 0 && ( c_filename != NULL || k_filename != NULL ) )
+  {
+    is_cache = get_cache_key(&cache_key);
+    if ( is_cache != 0 && get_from_cache(cache_key) != 0 )
+    {
+      if ( is_verbose != 0 )
+	printf("Cache: '%s' (%016llx) up to date\n", bdf_filename, (unsigned long long)cache_key);
+      return 1;
+    }
+  }
+  
   bf_desc_font = NULL;
   if ( desc_font_str[0] != '\0' )
   {
-    bf_desc_font = bf_OpenFromFile(desc_font_str, 0, BDF_BBX_MODE_MINIMAL, "*", "", "", 0, 0, 0, 1, 1);	/* assume format 0 for description, bdf_font.c */
+    bf_desc_font = open_font(desc_font_str, 0, BDF_BBX_MODE_MINIMAL, "*", "", "", 0, 0, 0, 1, 1);	/* assume format 0 for description, bdf_font.c */
     if ( bf_desc_font == NULL )
     {
-      exit(1);
+      return 0;
     }
   }
 
@@ -460,11 +631,13 @@ int main(int argc, char **argv)
   }
   
   /* render the complete font */
-  bf = bf_OpenFromFile(bdf_filename, is_verbose, build_bbx_mode, map_str, map_filename, utf8_filename, font_format, xoffset, yoffset, tile_h_size, tile_v_size); // bdf_font.c
+  bf = open_font(bdf_filename, is_verbose, build_bbx_mode, map_str, map_filename, utf8_filename, font_format, xoffset, yoffset, tile_h_size, tile_v_size); // bdf_font.c
   
   if ( bf == NULL )
   {
-    exit(1);
+    if ( bf_desc_font != NULL )
+      bf_Close(bf_desc_font);
+    return 0;
   }
 
   if ( font_format == 2 )
@@ -504,6 +677,7 @@ int main(int argc, char **argv)
 
       tga_save("bdf.tga");
     }
+    bf_Close(bf_desc_font);
   }
 
   
@@ -527,8 +701,154 @@ int main(int argc, char **argv)
     bdf_calculate_all_kerning(bf, k_filename, target_fontname, min_distance_in_per_cent_of_char_width);
   }
 
-
+  if ( is_cache != 0 )
+  {
+    put_to_cache(cache_key);
+  }
   
   bf_Close(bf);
+  return 1;
+}
+
+/*================================================*/
+/* batch mode */
+
+#define BATCH_LINE_LEN 4096
+#define BATCH_ARG_MAX 64
+
+/*
+  split a manifest line into arguments, '...' and "..." can be used for
+  arguments with spaces (e.g. -m '32-127, 160-255'), the line is modified
+*/
+int split_line(char *s, char **arg, int max)
+{
+  int cnt = 0;
+  char *d;
+  char quote;
+  for(;;)
+  {
+    while( *s == ' ' || *s == '\t' || *s == '\r' || *s == '\n' )
+      s++;
+    if ( *s == '\0' || *s == '#' )
+      break;
+    if ( cnt+1 >= max )
+      return -1;
+    arg[cnt++] = s;
+    d = s;
+    quote = '\0';
+    while( *s != '\0' )
+    {
+      if ( quote != '\0' )
+      {
+	if ( *s == quote )
+	  quote = '\0';
+	else
+	  *d++ = *s;
+      }
+      else if ( *s == '\'' || *s == '\"' )
+	quote = *s;
+      else if ( *s == ' ' || *s == '\t' || *s == '\r' || *s == '\n' )
+	break;
+      else
+	*d++ = *s;
+      s++;
+    }
+    if ( *s != '\0' )
+      s++;
+    *d = '\0';
+  }
+  arg[cnt] = NULL;
+  return cnt;
+}
+
+/*
+  each line of the manifest contains the arguments for one font,
+  the arguments from the command line are applied first,
+  returns the number of failed fonts
+*/
+int batch(char **cmd_argv, const char *manifest)
+{
+  FILE *fp;
+  static char line[BATCH_LINE_LEN];
+  char *arg[BATCH_ARG_MAX];
+  int line_nr = 0;
+  int cnt;
+  int err_cnt = 0;
+  int font_cnt = 0;
+  char *cmd_cache_dir = cache_dir;
+
+  fp = fopen(manifest, "r");
+  if ( fp == NULL )
+  {
+    printf("Batch: Can not open manifest '%s'\n", manifest);
+    return 1;
+  }
+  is_batch_mode = 1;
+  while( fgets(line, BATCH_LINE_LEN, fp) != NULL )
+  {
+    line_nr++;
+    cnt = split_line(line, arg, BATCH_ARG_MAX);
+    if ( cnt == 0 )
+      continue;
+    set_default_options();
+    cache_dir = cmd_cache_dir;
+    parse_args(cmd_argv);
+    batch_filename = NULL;
+    if ( cnt < 0 || parse_args(arg) == 0 || batch_filename != NULL || bdf_filename == NULL )
+    {
+      printf("Batch: %s:%d: Illegal arguments\n", manifest, line_nr);
+      err_cnt++;
+      continue;
+    }
+    font_cnt++;
+    if ( convert() == 0 )
+    {
+      printf("Batch: %s:%d: Conversion of '%s' failed\n", manifest, line_nr, bdf_filename);
+      err_cnt++;
+    }
+  }
+  fclose(fp);
+  clear_sources();
+  is_batch_mode = 0;
+  printf("Batch: %d fonts, %d errors\n", font_cnt, err_cnt);
+  return err_cnt;
+}
+
+/*================================================*/
+/* main */
+
+int main(int argc, char **argv)
+{
+  argv++;
+  /*
+  if ( *argv == NULL )
+  {
+    help();
+    exit(1);
+  }
+  */
+  if ( parse_args(argv) == 0 )
+  {
+    help();
+    exit(1);
+  }
+
+  if ( batch_filename != NULL )
+  {
+    if ( batch(argv, batch_filename) != 0 )
+      exit(1);
+    return 0;
+  }
+  
+  if ( bdf_filename  == NULL )
+  {
+    help();
+    exit(1);
+  }
+
+  if ( convert() == 0 )
+  {
+    exit(1);
+  }
   return 0;
 }
@@ -0,0 +1,119 @@
+# u8g2_select.cmake
+#
+# Build only the displays, which are used by the application.
+#
+# u8g2_select_displays(<csrc dir> <setup functions> <output file> <srcs var>)
+#
+#   <setup functions>   list of u8g2_Setup_...() functions, for example
+#                       "u8g2_Setup_ssd1306_i2c_72x40_er_f"
+#   <output file>       generated C file with the selected setup functions
+#                       and their buffer functions
+#   <srcs var>          list of C files, the caller's list is modified
+#
+# The selected functions are taken from u8g2_d_list.txt, which is generated by
+# tools/codebuild together with u8g2_d_setup.c and u8g2_d_memory.c. Each line
+# contains: setup function, display callback, cad callback, buffer function,
+# buffer size, buffer tile rows, ll_hvline procedure.
+# The output file has the same code as codebuild writes into u8g2_d_setup.c and
+# u8g2_d_memory.c and replaces both files. All u8x8_d_*.c files, which do not
+# contain a display callback of a selected setup function, are removed from
+# <srcs var>. Calling any other u8g2_Setup_...() function will fail at link time.
+
+set(U8G2_SELECT_LIST_FILE "${CMAKE_CURRENT_LIST_DIR}/u8g2_d_list.txt")
+
+function(u8g2_select_displays csrc_dir setup_functions output_file srcs_var)
+    set(list_file "${U8G2_SELECT_LIST_FILE}")
+    file(STRINGS "${list_file}" setup_list REGEX "^u8g2_Setup_")
+    file(GLOB driver_files "${csrc_dir}/u8x8_d_*.c")
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${list_file}")
+
+    set(setup_code "")
+    set(memory_code "")
+    set(buffers "")
+    set(used_driver_files "")
+    list(FILTER setup_functions EXCLUDE REGEX "^$")
+    list(REMOVE_DUPLICATES setup_functions)
+    foreach(setup IN LISTS setup_functions)
+        if(NOT setup MATCHES "^u8g2_Setup_[a-z0-9_]+$")
+            message(FATAL_ERROR "u8g2: '${setup}' is not a u8g2_Setup_...() function")
+        endif()
+        set(line ${setup_list})
+        list(FILTER line INCLUDE REGEX "^${setup} ")
+        if(line STREQUAL "")
+            message(FATAL_ERROR "u8g2: ${setup}() not found in u8g2_d_list.txt")
+        endif()
+        separate_arguments(fields UNIX_COMMAND "${line}")
+        list(LENGTH fields field_cnt)
+        if(NOT field_cnt EQUAL 7)
+            message(FATAL_ERROR "u8g2: unknown format of u8g2_d_list.txt: '${line}'")
+        endif()
+        list(GET fields 1 driver)
+        list(GET fields 2 cad)
+        list(GET fields 3 buffer)
+        list(GET fields 4 buffer_size)
+        list(GET fields 5 buffer_rows)
+        list(GET fields 6 ll_hvline)
+
+        # same code as do_display() of codebuild
+        string(APPEND setup_code
+            "void ${setup}(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)\n"
+            "{\n"
+            "  uint8_t tile_buf_height;\n"
+            "  uint8_t *buf;\n"
+            "  u8g2_SetupDisplay(u8g2, ${driver}, ${cad}, byte_cb, gpio_and_delay_cb);\n"
+            "  buf = ${buffer}(&tile_buf_height);\n"
+            "  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, ${ll_hvline}, rotation);\n"
+            "}\n")
+
+        # buffer function, shared by all setup functions with the same buffer size,
+        # same code as do_controller_buffer_code() of codebuild
+        if(NOT buffer IN_LIST buffers)
+            list(APPEND buffers "${buffer}")
+            string(APPEND memory_code
+                "uint8_t *${buffer}(uint8_t *page_cnt)\n"
+                "{\n"
+                "  #ifdef U8G2_USE_DYNAMIC_ALLOC\n"
+                "  *page_cnt = ${buffer_rows};\n"
+                "  return 0;\n"
+                "  #else\n"
+                "  static uint8_t buf[${buffer_size}] U8G2_BUFFER_ALIGNED;\n"
+                "  *page_cnt = ${buffer_rows};\n"
+                "  return buf;\n"
+                "  #endif\n"
+                "}\n")
+        endif()
+
+        # the display callback is the only reference into the u8x8_d_*.c files
+        set(driver_file "")
+        foreach(file IN LISTS driver_files)
+            file(STRINGS "${file}" found REGEX "^uint8_t ${driver}\\(")
+            if(found)
+                set(driver_file "${file}")
+                break()
+            endif()
+        endforeach()
+        if(driver_file STREQUAL "")
+            message(FATAL_ERROR "u8g2: display callback ${driver}() of ${setup}() not found")
+        endif()
+        list(APPEND used_driver_files "${driver_file}")
+    endforeach()
+
+    get_filename_component(output_name "${output_file}" NAME)
+    set(content "/* ${output_name} */\n/* generated code, tools/u8g2_select.cmake, u8g2 project */\n\n#include \"u8g2.h\"\n\n")
+    string(APPEND content "${memory_code}${setup_code}")
+    if(EXISTS "${output_file}")
+        file(READ "${output_file}" old_content)
+    endif()
+    if(NOT content STREQUAL old_content)
+        file(WRITE "${output_file}" "${content}")
+    endif()
+
+    set(srcs ${${srcs_var}})
+    list(REMOVE_ITEM srcs "${csrc_dir}/u8g2_d_setup.c" "${csrc_dir}/u8g2_d_memory.c")
+    list(REMOVE_ITEM driver_files ${used_driver_files})
+    if(driver_files)
+        list(REMOVE_ITEM srcs ${driver_files})
+    endif()
+    list(APPEND srcs "${output_file}")
+    set(${srcs_var} ${srcs} PARENT_SCOPE)
+endfunction()
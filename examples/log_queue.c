@@ -0,0 +1,118 @@
+/* Example: logging to the display from an ISR and from several tasks.
+   The producers only copy their text into a lock free u8log queue.
+   The display task drains all queues and redraws the display once per frame.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "driver/gptimer.h"
+#include "sdkconfig.h"
+
+#include "u8g2_esp32_hal.h"
+
+static const char *TAG = "log_queue";
+
+u8g2_esp32_hal_t u8g2_esp32_hal = U8G2_ESP32_HAL_DEFAULT;
+
+/* terminal size for a 72x40 display with a 5x7 font */
+#define LOG_WIDTH 14
+#define LOG_HEIGHT 5
+
+#define TIMER_RESOLUTION_HZ 1000000
+#define TIMER_PERIOD_US 250000
+
+static u8g2_t u8g2;
+static u8log_t u8log;
+static uint8_t u8log_buffer[LOG_WIDTH * LOG_HEIGHT];
+
+/* one queue for each producer, queue sizes must be a power of 2 */
+static u8log_queue_t isr_queue;
+static uint8_t isr_queue_buf[64];
+static u8log_queue_t worker_queue;
+static uint8_t worker_queue_buf[128];
+
+static volatile uint32_t alarm_count = 0;
+
+// GPTimer alarm callback (runs in ISR context)
+// u8log_queue_WriteString() does not block, it only copies the text.
+// The u8g2 code is not placed in IRAM, so CONFIG_GPTIMER_ISR_IRAM_SAFE must stay disabled.
+static bool IRAM_ATTR timer_alarm_cb(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_ctx)
+{
+    alarm_count++;
+    if ((alarm_count & 7) == 0) {
+        u8log_queue_WriteString(&isr_queue, "tick\n");
+    }
+    return false;
+}
+
+static void worker_task(void *arg)
+{
+    char line[LOG_WIDTH + 2];
+    uint32_t n = 0;
+    while (1) {
+        snprintf(line, sizeof(line), "work %lu\n", (unsigned long)n++);
+        u8log_queue_WriteString(&worker_queue, line);
+        vTaskDelay(pdMS_TO_TICKS(700));
+    }
+}
+
+void app_main(void)
+{
+    u8g2_esp32_hal.sda = 5;
+    u8g2_esp32_hal.scl = 6;
+    u8g2_esp32_hal_init(u8g2_esp32_hal);
+
+    u8g2_Setup_ssd1306_i2c_72x40_er_f(&u8g2, U8G2_R0, u8g2_esp32_i2c_byte_cb, u8g2_esp32_gpio_and_delay_cb);
+    u8x8_SetI2CAddress(&u8g2.u8x8, 0x78);
+    u8g2_InitDisplay(&u8g2);
+    u8g2_SetPowerSave(&u8g2, 0);
+    u8g2_SetFont(&u8g2, u8g2_font_5x7_tf);
+
+    u8log_Init(&u8log, LOG_WIDTH, LOG_HEIGHT, u8log_buffer);
+    u8log_SetCallback(&u8log, u8log_u8g2_cb, &u8g2);
+
+    /* queues must be added before the producers are started */
+    u8log_queue_Init(&isr_queue, isr_queue_buf, sizeof(isr_queue_buf));
+    u8log_AddQueue(&u8log, &isr_queue);
+    u8log_queue_Init(&worker_queue, worker_queue_buf, sizeof(worker_queue_buf));
+    u8log_AddQueue(&u8log, &worker_queue);
+
+    gptimer_handle_t timer = NULL;
+    gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = TIMER_RESOLUTION_HZ,
+    };
+    ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &timer));
+    gptimer_event_callbacks_t cbs = {
+        .on_alarm = timer_alarm_cb,
+    };
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(timer, &cbs, NULL));
+    gptimer_alarm_config_t alarm_config = {
+        .alarm_count = TIMER_PERIOD_US,
+        .reload_count = 0,
+        .flags = {
+            .auto_reload_on_alarm = true,
+        }
+    };
+    ESP_ERROR_CHECK(gptimer_set_alarm_action(timer, &alarm_config));
+    ESP_ERROR_CHECK(gptimer_enable(timer));
+    ESP_ERROR_CHECK(gptimer_start(timer));
+
+    xTaskCreate(worker_task, "worker", 2048, NULL, 5, NULL);
+
+    // Display task: all text which arrived since the last frame is drawn with one redraw
+    uint16_t last_drops = 0;
+    while (1) {
+        u8log_DrainQueues(&u8log);
+
+        uint16_t drops = u8log_queue_GetDropCount(&isr_queue) + u8log_queue_GetDropCount(&worker_queue);
+        if (drops != last_drops) {
+            ESP_LOGW(TAG, "%u log messages dropped", (unsigned)(drops - last_drops));
+            last_drops = drops;
+        }
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+}
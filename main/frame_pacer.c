@@ -0,0 +1,178 @@
+#include <string.h>
+#include "frame_pacer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "helpers.h"
+#include "u8g2_esp32_hal.h"
+
+/* FNV-1a, only used to detect a change of the buffer if there is no shadow copy */
+static uint32_t frame_pacer_hash(const uint8_t *data, size_t len)
+{
+    uint32_t h = 2166136261UL;
+    while (len > 0) {
+        h ^= *data++;
+        h *= 16777619UL;
+        len--;
+    }
+    return h;
+}
+
+static void frame_pacer_reset_stats(frame_pacer_t *pacer, int64_t now)
+{
+    frame_pacer_stats_t *stats = &pacer->stats;
+    stats->window_start_us = now;
+    stats->sleep_us = 0;
+    stats->jitter_sum_us = 0;
+    stats->jitter_max_us = 0;
+    stats->frames = 0;
+    stats->sent = 0;
+    stats->overruns = 0;
+}
+
+void frame_pacer_init(frame_pacer_t *pacer, u8g2_t *u8g2, uint32_t target_fps, frame_render_cb_t render_cb, void *arg, uint8_t *shadow)
+{
+    pacer->u8g2 = u8g2;
+    pacer->render_cb = render_cb;
+    pacer->arg = arg;
+    pacer->shadow = shadow;
+    pacer->is_frame_valid = false;
+    pacer->last_hash = 0;
+    frame_pacer_set_fps(pacer, target_fps);
+    frame_pacer_reset_stats(pacer, pacer->next_frame_us);
+}
+
+void frame_pacer_set_fps(frame_pacer_t *pacer, uint32_t target_fps)
+{
+    if (target_fps == 0) {
+        target_fps = 1;
+    }
+    pacer->period_us = 1000000UL / target_fps;
+    pacer->next_frame_us = esp_timer_get_time();
+}
+
+void frame_pacer_invalidate(frame_pacer_t *pacer)
+{
+    pacer->is_frame_valid = false;
+}
+
+/* wait until the start of the next frame, returns the time spent waiting */
+static int64_t frame_pacer_wait(frame_pacer_t *pacer)
+{
+    const int64_t tick_us = portTICK_PERIOD_MS * 1000LL;
+    int64_t start = esp_timer_get_time();
+    int64_t slack_us = pacer->next_frame_us - start;
+
+    if (slack_us >= FRAME_PACER_LIGHT_SLEEP_MIN_US) {
+        light_sleep_delay_ms((uint32_t)(slack_us / 1000));
+        slack_us = pacer->next_frame_us - esp_timer_get_time();
+    }
+    /* remaining time (or all of it for short periods) with the scheduler, rounded to the nearest tick */
+    if (slack_us > 0) {
+        TickType_t ticks = (TickType_t)((slack_us + tick_us / 2) / tick_us);
+        if (ticks > 0) {
+            vTaskDelay(ticks);
+        }
+    }
+    return esp_timer_get_time() - start;
+}
+
+/* returns true if the buffer differs from the frame on the display */
+static bool frame_pacer_is_changed(frame_pacer_t *pacer, const uint8_t *buf, size_t len)
+{
+    if (pacer->shadow != NULL) {
+        return !pacer->is_frame_valid || memcmp(buf, pacer->shadow, len) != 0;
+    }
+    uint32_t hash = frame_pacer_hash(buf, len);
+    bool is_changed = !pacer->is_frame_valid || hash != pacer->last_hash;
+    pacer->last_hash = hash;
+    return is_changed;
+}
+
+bool frame_pacer_run_frame(frame_pacer_t *pacer)
+{
+    frame_pacer_stats_t *stats = &pacer->stats;
+    u8g2_t *u8g2 = pacer->u8g2;
+    bool is_sent = false;
+    int64_t start = esp_timer_get_time();
+    int64_t deviation = start - pacer->next_frame_us;
+
+    if (deviation < 0) {
+        deviation = -deviation;
+    }
+    stats->jitter_sum_us += deviation;
+    if (deviation > stats->jitter_max_us) {
+        stats->jitter_max_us = (uint32_t)deviation;
+    }
+
+    u8g2_ClearBuffer(u8g2);
+    pacer->render_cb(u8g2, pacer->arg);
+
+    uint8_t *buf = u8g2_GetBufferPtr(u8g2);
+    size_t len = u8g2_GetBufferSize(u8g2);
+    if (frame_pacer_is_changed(pacer, buf, len)) {
+        /* a pending contrast of the fade engine is sent in the same transaction */
+        if (u8g2_esp32_send_buffer(u8g2) == ESP_OK) {
+            if (pacer->shadow != NULL) {
+                memcpy(pacer->shadow, buf, len);
+            }
+            pacer->is_frame_valid = true;
+            stats->sent++;
+            is_sent = true;
+        } else {
+            /* the display shows a partial frame, send the next frame in any case */
+            pacer->is_frame_valid = false;
+        }
+    } else {
+        u8g2_esp32_fade_flush(u8g2);
+    }
+    stats->frames++;
+
+    int64_t end = esp_timer_get_time();
+
+    /* keep the cadence: the next frame is scheduled relative to the last deadline, not to "end" */
+    pacer->next_frame_us += pacer->period_us;
+    if (pacer->next_frame_us < end) {
+        /* deadline missed, restart the cadence instead of trying to catch up */
+        stats->overruns++;
+        pacer->next_frame_us = end;
+    }
+    stats->sleep_us += frame_pacer_wait(pacer);
+    return is_sent;
+}
+
+void frame_pacer_get_report(frame_pacer_t *pacer, frame_pacer_report_t *report)
+{
+    frame_pacer_stats_t *stats = &pacer->stats;
+    int64_t now = esp_timer_get_time();
+    int64_t elapsed_us = now - stats->window_start_us;
+
+    report->fps = 0.0f;
+    report->duty_cycle = 0.0f;
+    if (elapsed_us > 0) {
+        report->fps = (float)stats->frames * 1000000.0f / (float)elapsed_us;
+        /* wall time minus the actual waiting time: includes everything between two frames */
+        int64_t awake_us = elapsed_us - stats->sleep_us;
+        if (awake_us < 0) {
+            awake_us = 0;
+        }
+        report->duty_cycle = (float)awake_us * 100.0f / (float)elapsed_us;
+    }
+    report->jitter_avg_us = stats->frames > 0 ? (uint32_t)(stats->jitter_sum_us / stats->frames) : 0;
+    report->jitter_max_us = stats->jitter_max_us;
+    report->frames = stats->frames;
+    report->sent = stats->sent;
+    report->overruns = stats->overruns;
+    frame_pacer_reset_stats(pacer, now);
+}
+
+void frame_pacer_log_report(frame_pacer_t *pacer, const char *tag)
+{
+    frame_pacer_report_t report;
+    frame_pacer_get_report(pacer, &report);
+    ESP_LOGI(tag, "%.2f fps, jitter avg %lu us max %lu us, awake %.1f%%, %lu/%lu frames sent, %lu overruns",
+             report.fps, (unsigned long)report.jitter_avg_us, (unsigned long)report.jitter_max_us,
+             report.duty_cycle, (unsigned long)report.sent, (unsigned long)report.frames,
+             (unsigned long)report.overruns);
+}
@@ -0,0 +1,99 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "u8g2.h"
+
+/* Use light sleep only if at least this much time is left until the next frame */
+#ifndef FRAME_PACER_LIGHT_SLEEP_MIN_US
+#define FRAME_PACER_LIGHT_SLEEP_MIN_US 20000
+#endif
+
+/**
+ * @brief Draws one frame into the u8g2 buffer, the buffer is cleared before the call
+ */
+typedef void (*frame_render_cb_t)(u8g2_t *u8g2, void *arg);
+
+/**
+ * @brief Statistics since the last call to frame_pacer_get_report()
+ */
+typedef struct {
+    int64_t window_start_us;    /* start of the statistics window */
+    int64_t sleep_us;           /* time spent waiting for the next frame */
+    int64_t jitter_sum_us;      /* sum of the frame start deviations */
+    uint32_t jitter_max_us;     /* largest frame start deviation */
+    uint32_t frames;            /* rendered frames */
+    uint32_t sent;              /* frames sent to the display */
+    uint32_t overruns;          /* frames, which missed their deadline */
+} frame_pacer_stats_t;
+
+typedef struct {
+    u8g2_t *u8g2;
+    frame_render_cb_t render_cb;
+    void *arg;
+    uint32_t period_us;
+    int64_t next_frame_us;      /* scheduled start of the next frame */
+    uint8_t *shadow;            /* copy of the buffer, which is shown on the display, NULL: use last_hash */
+    uint32_t last_hash;         /* hash of the buffer, which is shown on the display */
+    bool is_frame_valid;        /* false: the next frame is sent in any case */
+    frame_pacer_stats_t stats;
+} frame_pacer_t;
+
+typedef struct {
+    float fps;                  /* achieved frames per second */
+    float duty_cycle;           /* time not spent waiting for the next frame, in percent of the elapsed time */
+    uint32_t jitter_avg_us;
+    uint32_t jitter_max_us;
+    uint32_t frames;
+    uint32_t sent;              /* frames - sent = skipped transfers */
+    uint32_t overruns;
+} frame_pacer_report_t;
+
+/**
+ * @brief Setup the frame pacer for a u8g2 object in full buffer mode
+ * @param target_fps Frames per second, the render callback is called with this rate
+ * @param render_cb Draws a frame, arg is passed to the callback
+ * @param shadow Memory for a copy of the last sent frame, u8g2_GetBufferSize() bytes.
+ *               If NULL, only a hash of the last frame is stored, see frame_pacer_run_frame().
+ */
+void frame_pacer_init(frame_pacer_t *pacer, u8g2_t *u8g2, uint32_t target_fps, frame_render_cb_t render_cb, void *arg, uint8_t *shadow);
+
+/**
+ * @brief Change the target frame rate, the next frame starts immediately
+ */
+void frame_pacer_set_fps(frame_pacer_t *pacer, uint32_t target_fps);
+
+/**
+ * @brief Force a transfer of the next frame, even if the buffer did not change
+ *
+ * Call this after the display was modified outside of the frame pacer,
+ * for example after u8g2_ClearDisplay() or u8g2_InitDisplay().
+ */
+void frame_pacer_invalidate(frame_pacer_t *pacer);
+
+/**
+ * @brief Render one frame, send it if it has changed and wait for the start of the next frame
+ * @return true if the frame was sent to the display
+ *
+ * The buffer is compared with the shadow copy of the last sent frame after rendering.
+ * If it is unchanged, the bus transfer is skipped. Without a shadow copy, the hash of
+ * the buffer is compared instead: This is lossy, a hash collision will skip a changed
+ * frame (until the next change of the buffer). A contrast update of the fade engine
+ * (u8g2_esp32_fade_start()) is sent together with the frame. The waiting time is the remaining
+ * part of the frame period. Light sleep is used if the remaining time is at
+ * least FRAME_PACER_LIGHT_SLEEP_MIN_US, otherwise vTaskDelay() is used.
+ */
+bool frame_pacer_run_frame(frame_pacer_t *pacer);
+
+/**
+ * @brief Calculate frame rate, jitter and duty cycle and start a new statistics window
+ */
+void frame_pacer_get_report(frame_pacer_t *pacer, frame_pacer_report_t *report);
+
+/**
+ * @brief Same as frame_pacer_get_report(), but writes the report to the log
+ */
+void frame_pacer_log_report(frame_pacer_t *pacer, const char *tag);
+
+#endif // FRAME_PACER_H
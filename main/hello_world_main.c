@@ -7,6 +7,7 @@ software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
 CONDITIONS OF ANY KIND, either express or implied.
 */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -15,6 +16,7 @@ CONDITIONS OF ANY KIND, either express or implied.
 
 #include "u8g2_esp32_hal.h"
 #include "helpers.h"
+#include "frame_pacer.h"
 static const char *TAG = "example";
 
 u8g2_esp32_hal_t u8g2_esp32_hal = U8G2_ESP32_HAL_DEFAULT;
@@ -26,8 +28,56 @@ u8g2_esp32_hal_t u8g2_esp32_hal = U8G2_ESP32_HAL_DEFAULT;
 /* Target frames per second */
 #define TARGET_FPS 5
 
-/* Calculate frame delay in milliseconds from FPS */
-#define FRAME_DELAY_MS (1000 / TARGET_FPS)
+/* Statistics of the frame pacer are written to the log every REPORT_INTERVAL_S seconds */
+#define REPORT_INTERVAL_S 10
+
+typedef struct {
+    uint8_t counter;
+    char display_str[16];
+    u8g2_str_run_t text_run;
+    u8g2_str_glyph_t text_glyph[16];
+} frame_state_t;
+
+/* Render callback for the frame pacer, the buffer is already cleared */
+static void render_frame(u8g2_t *u8g2, void *arg)
+{
+    frame_state_t *state = arg;
+    uint8_t counter = state->counter;
+
+    /* Fade the brightness from counter 1 (dimmest) to counter 10 (brightest).
+       The fade engine sends the contrast together with the frames. */
+    if (counter == 1) {
+        u8g2_esp32_fade_start(OLED_CONTRAST_MIN, OLED_CONTRAST_MAX, 9 * 1000 / TARGET_FPS, U8G2_ESP32_FADE_LINEAR);
+    }
+
+    snprintf(state->display_str, sizeof(state->display_str), "%d", counter);
+
+    /* Center text horizontally and vertically, the glyphs are looked up only once for measure and draw */
+    u8g2_LayoutStr(u8g2, &state->text_run, state->text_glyph, sizeof(state->text_glyph)/sizeof(state->text_glyph[0]), state->display_str);
+    int16_t text_width = u8g2_GetStrRunWidth(&state->text_run);
+    int16_t display_width = u8g2_GetDisplayWidth(u8g2);
+    int16_t display_height = u8g2_GetDisplayHeight(u8g2);
+    int16_t font_ascent = u8g2_GetFontAscent(u8g2);
+
+    int16_t x = (display_width - text_width) / 2;
+    int16_t y = (display_height + font_ascent) / 2;
+
+    u8g2_DrawStrRun(u8g2, x, y, &state->text_run);
+
+    /* Draw a small moving dot from top-left to top-right */
+    /* Counter 1 = top-left (0,0), Counter 10 = top-right */
+    int16_t dot_x = ((counter - 1) * (display_width - 1)) / 9;
+    int16_t dot_y = 0;  /* Stay at top edge */
+
+    /* Draw a 2x2 pixel dot for visibility */
+    u8g2_DrawBox(u8g2, dot_x, dot_y, 2, 2);
+
+    counter++;
+    if (counter > 10) {
+        counter = 1;
+    }
+    state->counter = counter;
+}
 
 void app_main(void)
 {
@@ -44,6 +94,11 @@ void app_main(void)
     u8g2_t u8g2;
     u8g2_Setup_ssd1306_i2c_72x40_er_f(&u8g2, U8G2_R0, u8g2_esp32_i2c_byte_cb, u8g2_esp32_gpio_and_delay_cb);
     u8x8_SetI2CAddress(&u8g2.u8x8, 0x78);
+#ifdef U8G2_USE_DYNAMIC_ALLOC
+    /* CONFIG_U8G2_USE_DYNAMIC_ALLOC: no static buffer is linked, allocate it from DMA capable memory */
+    static uint8_t *frame_buffers[1];
+    ESP_ERROR_CHECK(u8g2_esp32_alloc_buffers(&u8g2, frame_buffers, 1));
+#endif
     u8g2_InitDisplay(&u8g2);
     u8g2_SetPowerSave(&u8g2, 0);
     ESP_LOGI(TAG, "OLED display initialized");
@@ -62,46 +117,19 @@ void app_main(void)
     u8g2_SetFont(&u8g2, u8g2_font_bpixeldouble_tr);
     ESP_LOGI(TAG, "Starting number cycle...");
 
-    uint8_t counter = 1;
-    char display_str[16];
+    static frame_state_t state = { .counter = 1 };
+    frame_pacer_t pacer;
+    /* copy of the last sent frame, without it the pacer compares a hash of the buffer */
+    uint8_t *frame_shadow = malloc(u8g2_GetBufferSize(&u8g2));
+    frame_pacer_init(&pacer, &u8g2, TARGET_FPS, render_frame, &state, frame_shadow);
 
     while (1)
     {
-        /* Calculate brightness based on counter (1 = dimmest, 10 = brightest) */
-        uint8_t contrast = OLED_CONTRAST_MIN + ((counter - 1) * (OLED_CONTRAST_MAX - OLED_CONTRAST_MIN)) / 9;
-        u8g2_SetContrast(&u8g2, contrast);
-
-        /* Update display with current counter */
-        u8g2_ClearBuffer(&u8g2);
-        snprintf(display_str, sizeof(display_str), "%d", counter);
-
-        /* Center text horizontally and vertically */
-        int16_t text_width = u8g2_GetStrWidth(&u8g2, display_str);
-        int16_t display_width = u8g2_GetDisplayWidth(&u8g2);
-        int16_t display_height = u8g2_GetDisplayHeight(&u8g2);
-        int16_t font_ascent = u8g2_GetFontAscent(&u8g2);
+        frame_pacer_run_frame(&pacer);
 
-        int16_t x = (display_width - text_width) / 2;
-        int16_t y = (display_height + font_ascent) / 2;
-
-        u8g2_DrawStr(&u8g2, x, y, display_str);
-
-        /* Draw a small moving dot from top-left to top-right */
-        /* Counter 1 = top-left (0,0), Counter 10 = top-right */
-        int16_t dot_x = ((counter - 1) * (display_width - 1)) / 9;
-        int16_t dot_y = 0;  /* Stay at top edge */
-
-        /* Draw a 2x2 pixel dot for visibility */
-        u8g2_DrawBox(&u8g2, dot_x, dot_y, 2, 2);
-
-        u8g2_SendBuffer(&u8g2);
-
-        counter++;
-        if (counter > 10) {
-            counter = 1;
+        if (pacer.stats.frames >= TARGET_FPS * REPORT_INTERVAL_S) {
+            frame_pacer_log_report(&pacer, TAG);
         }
-
-        vTaskDelay(pdMS_TO_TICKS(FRAME_DELAY_MS));
     }
 }
-// usb upload sometimes fails, not sure why, i did not do anything other than press upload again.
\ No newline at end of file
+// usb upload sometimes fails, not sure why, i did not do anything other than press upload again.
\ No newline at end of file
@@ -7,13 +7,19 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+#include "soc/gpio_reg.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
 #include "u8g2_esp32_hal.h"
 
 static const char *TAG = "u8g2_hal";
 static const unsigned int I2C_TIMEOUT_MS = 1000;
 
 static spi_device_handle_t handle_spi;	// SPI handle.
-static i2c_cmd_handle_t handle_i2c;		// I2C handle.
+static i2c_cmd_handle_t handle_i2c = NULL;	// I2C handle.
+static bool i2c_batch = false;			// collect all I2C transfers in handle_i2c, see u8g2_esp32_send_buffer()
+static esp_err_t i2c_err = ESP_OK;		// first failed transfer since the start of the batch
 static u8g2_esp32_hal_t u8g2_esp32_hal; // HAL state data.
 
 #undef ESP_ERROR_CHECK
@@ -110,6 +116,44 @@ uint8_t u8g2_esp32_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 	return 0;
 } // u8g2_esp32_spi_byte_cb
 
+/*
+ * The bytes of the I2C transfers are copied to i2c_buf and each transfer is queued with
+ * one i2c_master_write() into the command link in i2c_link. The queued transfers refer to
+ * i2c_buf, so the buffer is only reused after the command link was executed.
+ */
+static uint8_t i2c_buf[U8G2_ESP32_I2C_BUF_SIZE];
+static uint8_t i2c_link[I2C_LINK_RECOMMENDED_SIZE(U8G2_ESP32_I2C_MAX_TRANSFERS)];
+static uint16_t i2c_buf_len = 0;		// used bytes of i2c_buf, including the current transfer
+static uint16_t i2c_transfer_start = 0; // start of the current transfer in i2c_buf
+static uint16_t i2c_transfer_cnt = 0;	// transfers in handle_i2c
+static bool i2c_overflow = false;		// the current transfer does not fit into i2c_buf
+
+// Execute and delete the command link. A failed transfer is logged and stored in i2c_err,
+// in batch mode the remaining transfers of the frame are dropped after an error.
+static void i2c_execute(void)
+{
+	if (handle_i2c != NULL)
+	{
+		if (!i2c_batch || i2c_err == ESP_OK)
+		{
+			esp_err_t rc = i2c_master_cmd_begin(I2C_MASTER_NUM, handle_i2c, I2C_TIMEOUT_MS / portTICK_PERIOD_MS);
+			if (rc != ESP_OK)
+			{
+				ESP_LOGW(TAG, "I2C transfer to %02X failed: %s", i2c_buf[0] >> 1, esp_err_to_name(rc));
+				if (i2c_err == ESP_OK)
+				{
+					i2c_err = rc;
+				}
+			}
+		}
+		i2c_cmd_link_delete_static(handle_i2c);
+		handle_i2c = NULL;
+	}
+	i2c_transfer_cnt = 0;
+	i2c_buf_len = 0;
+	i2c_transfer_start = 0;
+}
+
 /*
  * HAL callback function as prescribed by the U8G2 library.  This callback is invoked
  * to handle I2C communications.
@@ -167,37 +211,139 @@ uint8_t u8g2_esp32_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 		uint8_t *data_ptr = (uint8_t *)arg_ptr;
 		ESP_LOG_BUFFER_HEXDUMP(TAG, data_ptr, arg_int, ESP_LOG_VERBOSE);
 
-		while (arg_int > 0)
+		if (i2c_buf_len + arg_int > sizeof(i2c_buf) && i2c_transfer_start > 0)
 		{
-			ESP_ERROR_CHECK(i2c_master_write_byte(handle_i2c, *data_ptr, ACK_CHECK_EN));
-			data_ptr++;
-			arg_int--;
+			// execute the queued transfers and move the current transfer to the start of i2c_buf
+			uint16_t start = i2c_transfer_start;
+			uint16_t len = i2c_buf_len - start;
+			i2c_execute();
+			memmove(i2c_buf, i2c_buf + start, len);
+			i2c_buf_len = len;
 		}
+		if (i2c_buf_len + arg_int > sizeof(i2c_buf))
+		{
+			i2c_overflow = true;
+			break;
+		}
+		memcpy(i2c_buf + i2c_buf_len, data_ptr, arg_int);
+		i2c_buf_len += arg_int;
 		break;
 	}
 
 	case U8X8_MSG_BYTE_START_TRANSFER:
 	{
 		uint8_t i2c_address = u8x8_GetI2CAddress(u8x8);
-		handle_i2c = i2c_cmd_link_create();
+		// In batch mode, the transfers are collected until i2c_buf or i2c_link is full
+		if (i2c_transfer_cnt >= U8G2_ESP32_I2C_MAX_TRANSFERS || i2c_buf_len >= sizeof(i2c_buf))
+		{
+			i2c_execute();
+		}
 		ESP_LOGD(TAG, "Start I2C transfer to %02X.", i2c_address >> 1);
-		ESP_ERROR_CHECK(i2c_master_start(handle_i2c));
-		ESP_ERROR_CHECK(i2c_master_write_byte(handle_i2c, i2c_address | I2C_MASTER_WRITE, ACK_CHECK_EN));
+		i2c_transfer_start = i2c_buf_len;
+		i2c_buf[i2c_buf_len++] = i2c_address | I2C_MASTER_WRITE;
+		i2c_overflow = false;
 		break;
 	}
 
 	case U8X8_MSG_BYTE_END_TRANSFER:
 	{
 		ESP_LOGD(TAG, "End I2C transfer.");
-		ESP_ERROR_CHECK(i2c_master_stop(handle_i2c));
-		ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_MASTER_NUM, handle_i2c, I2C_TIMEOUT_MS / portTICK_PERIOD_MS));
-		i2c_cmd_link_delete(handle_i2c);
+		if (i2c_overflow)
+		{
+			ESP_LOGE(TAG, "I2C transfer does not fit into U8G2_ESP32_I2C_BUF_SIZE, dropped");
+			if (i2c_err == ESP_OK)
+			{
+				i2c_err = ESP_ERR_INVALID_SIZE;
+			}
+			i2c_buf_len = i2c_transfer_start;
+		}
+		else
+		{
+			if (handle_i2c == NULL)
+			{
+				handle_i2c = i2c_cmd_link_create_static(i2c_link, sizeof(i2c_link));
+			}
+			// i2c_link has space for U8G2_ESP32_I2C_MAX_TRANSFERS transfers, queueing can not fail
+			ESP_ERROR_CHECK(i2c_master_start(handle_i2c));
+			ESP_ERROR_CHECK(i2c_master_write(handle_i2c, i2c_buf + i2c_transfer_start, i2c_buf_len - i2c_transfer_start, ACK_CHECK_EN));
+			ESP_ERROR_CHECK(i2c_master_stop(handle_i2c));
+			i2c_transfer_cnt++;
+		}
+		if (!i2c_batch)
+		{
+			i2c_execute();
+		}
 		break;
 	}
 	}
 	return 0;
 } // u8g2_esp32_i2c_byte_cb
 
+static bool sw_spi_pins_ready = false;
+static bool sw_i2c_pins_ready = false;
+
+// Software SPI: clock and data are push-pull outputs
+static void sw_spi_pins_init(void)
+{
+	uint64_t bitmask = 0;
+	if (sw_spi_pins_ready)
+	{
+		return;
+	}
+	sw_spi_pins_ready = true;
+	if (u8g2_esp32_hal.clk != U8G2_ESP32_HAL_UNDEFINED)
+	{
+		bitmask = bitmask | (1ull << u8g2_esp32_hal.clk);
+	}
+	if (u8g2_esp32_hal.mosi != U8G2_ESP32_HAL_UNDEFINED)
+	{
+		bitmask = bitmask | (1ull << u8g2_esp32_hal.mosi);
+	}
+	if (bitmask == 0)
+	{
+		return;
+	}
+	gpio_config_t gpioConfig;
+	gpioConfig.pin_bit_mask = bitmask;
+	gpioConfig.mode = GPIO_MODE_OUTPUT;
+	gpioConfig.pull_up_en = GPIO_PULLUP_DISABLE;
+	gpioConfig.pull_down_en = GPIO_PULLDOWN_ENABLE;
+	gpioConfig.intr_type = GPIO_INTR_DISABLE;
+	gpio_config(&gpioConfig);
+}
+
+// Software I2C: the lines are open drain and released (high) before they become outputs
+static void sw_i2c_pins_init(void)
+{
+	uint64_t od_bitmask = 0;
+	if (sw_i2c_pins_ready)
+	{
+		return;
+	}
+	sw_i2c_pins_ready = true;
+	if (u8g2_esp32_hal.scl != U8G2_ESP32_HAL_UNDEFINED)
+	{
+		gpio_set_level(u8g2_esp32_hal.scl, 1);
+		od_bitmask = od_bitmask | (1ull << u8g2_esp32_hal.scl);
+	}
+	if (u8g2_esp32_hal.sda != U8G2_ESP32_HAL_UNDEFINED)
+	{
+		gpio_set_level(u8g2_esp32_hal.sda, 1);
+		od_bitmask = od_bitmask | (1ull << u8g2_esp32_hal.sda);
+	}
+	if (od_bitmask == 0)
+	{
+		return;
+	}
+	gpio_config_t odConfig;
+	odConfig.pin_bit_mask = od_bitmask;
+	odConfig.mode = GPIO_MODE_INPUT_OUTPUT_OD;
+	odConfig.pull_up_en = GPIO_PULLUP_ENABLE;
+	odConfig.pull_down_en = GPIO_PULLDOWN_DISABLE;
+	odConfig.intr_type = GPIO_INTR_DISABLE;
+	gpio_config(&odConfig);
+}
+
 /*
  * HAL callback function as prescribed by the U8G2 library.  This callback is invoked
  * to handle callbacks for GPIO and delay functions.
@@ -226,6 +372,11 @@ uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 			bitmask = bitmask | (1ull << u8g2_esp32_hal.cs);
 		}
 
+		// The software SPI and I2C lines are configured with the first message of a software
+		// byte procedure, the hardware SPI and I2C drivers route these pins themselves.
+		sw_spi_pins_ready = false;
+		sw_i2c_pins_ready = false;
+
 		if (bitmask == 0)
 		{
 			break;
@@ -256,6 +407,7 @@ uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 		break;
 		// Set the Software I²C pin to the value passed in through arg_int.
 	case U8X8_MSG_GPIO_I2C_CLOCK:
+		sw_i2c_pins_init();
 		if (u8g2_esp32_hal.scl != U8G2_ESP32_HAL_UNDEFINED)
 		{
 			gpio_set_level(u8g2_esp32_hal.scl, arg_int);
@@ -264,6 +416,7 @@ uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 		break;
 		// Set the Software I²C pin to the value passed in through arg_int.
 	case U8X8_MSG_GPIO_I2C_DATA:
+		sw_i2c_pins_init();
 		if (u8g2_esp32_hal.sda != U8G2_ESP32_HAL_UNDEFINED)
 		{
 			gpio_set_level(u8g2_esp32_hal.sda, arg_int);
@@ -271,6 +424,49 @@ uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 		}
 		break;
 
+		// Set the Software SPI pins to the value passed in through arg_int.
+	case U8X8_MSG_GPIO_SPI_CLOCK:
+		sw_spi_pins_init();
+		if (u8g2_esp32_hal.clk != U8G2_ESP32_HAL_UNDEFINED)
+		{
+			gpio_set_level(u8g2_esp32_hal.clk, arg_int);
+		}
+		break;
+	case U8X8_MSG_GPIO_SPI_DATA:
+		sw_spi_pins_init();
+		if (u8g2_esp32_hal.mosi != U8G2_ESP32_HAL_UNDEFINED)
+		{
+			gpio_set_level(u8g2_esp32_hal.mosi, arg_int);
+		}
+		break;
+
+		// Provide the set/clear registers for u8x8_byte_4wire_sw_spi_fast and u8x8_byte_sw_i2c_fast.
+		// Only pins 0..31 are handled by GPIO_OUT_W1TS_REG/GPIO_OUT_W1TC_REG.
+	case U8X8_MSG_GPIO_FAST_IO:
+	{
+		u8x8_fast_io_t *io = (u8x8_fast_io_t *)arg_ptr;
+		gpio_num_t clock = (arg_int == U8X8_FAST_IO_I2C) ? u8g2_esp32_hal.scl : u8g2_esp32_hal.clk;
+		gpio_num_t data = (arg_int == U8X8_FAST_IO_I2C) ? u8g2_esp32_hal.sda : u8g2_esp32_hal.mosi;
+		if (clock == U8G2_ESP32_HAL_UNDEFINED || data == U8G2_ESP32_HAL_UNDEFINED || clock >= 32 || data >= 32)
+		{
+			return 0;
+		}
+		if (arg_int == U8X8_FAST_IO_I2C)
+		{
+			sw_i2c_pins_init();
+		}
+		else
+		{
+			sw_spi_pins_init();
+		}
+		io->set_reg = (volatile uint32_t *)GPIO_OUT_W1TS_REG;
+		io->clr_reg = (volatile uint32_t *)GPIO_OUT_W1TC_REG;
+		io->clock_mask = 1ul << clock;
+		io->data_mask = 1ul << data;
+		io->delay_cnt = (arg_int == U8X8_FAST_IO_I2C) ? U8G2_ESP32_FAST_I2C_DELAY_CNT : U8G2_ESP32_FAST_SPI_DELAY_CNT;
+		return 1;
+	}
+
 		// Delay for the number of milliseconds passed in through arg_int.
 	case U8X8_MSG_DELAY_MILLI:
 		vTaskDelay(arg_int / portTICK_PERIOD_MS);
@@ -278,3 +474,185 @@ uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 	}
 	return 0;
 } // u8g2_esp32_gpio_and_delay_cb
+
+/*
+ * Contrast fade engine.
+ * The contrast of the running fade is calculated from esp_timer_get_time() when a frame
+ * is sent: The contrast can only reach the display together with a transfer, so no timer
+ * is required and the fade keeps its duration, even across light sleep.
+ * fade_start() and the send procedures might be called from different tasks, the fade
+ * state is protected by fade_lock.
+ */
+static portMUX_TYPE fade_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool fade_active = false;
+static bool fade_pending = false; // fade_contrast is not yet sent to the display
+static uint8_t fade_contrast;
+static int64_t fade_start_us;
+static uint32_t fade_duration_us;
+static uint8_t fade_start_value;
+static uint8_t fade_end_value;
+static u8g2_esp32_fade_easing_t fade_easing;
+
+// Returns the contrast for the time "now", fade_active is cleared at the end of the fade, requires fade_lock
+static uint8_t fade_calc_contrast(int64_t now)
+{
+	int64_t elapsed = now - fade_start_us;
+	uint32_t t; // progress 0..65536
+	uint32_t e; // eased progress 0..65536
+
+	if (elapsed >= fade_duration_us)
+	{
+		fade_active = false;
+		return fade_end_value;
+	}
+	if (elapsed < 0)
+	{
+		elapsed = 0;
+	}
+	t = (uint32_t)((elapsed << 16) / fade_duration_us);
+	switch (fade_easing)
+	{
+	case U8G2_ESP32_FADE_EASE_IN:
+		e = (uint32_t)(((uint64_t)t * t) >> 16);
+		break;
+	case U8G2_ESP32_FADE_EASE_OUT:
+		e = 65536 - (uint32_t)(((uint64_t)(65536 - t) * (65536 - t)) >> 16);
+		break;
+	case U8G2_ESP32_FADE_EASE_IN_OUT:
+		e = (uint32_t)(((uint64_t)t * t * (3 * 65536 - 2 * t)) >> 32);
+		break;
+	default:
+		e = t;
+		break;
+	}
+	return fade_start_value + ((int32_t)(fade_end_value - fade_start_value) * (int32_t)e) / 65536;
+}
+
+void u8g2_esp32_fade_start(uint8_t start, uint8_t end, uint32_t duration_ms, u8g2_esp32_fade_easing_t easing)
+{
+	int64_t now = esp_timer_get_time();
+
+	taskENTER_CRITICAL(&fade_lock);
+	fade_start_value = start;
+	fade_end_value = end;
+	fade_duration_us = duration_ms > 0 ? duration_ms * 1000 : 1;
+	fade_easing = easing;
+	fade_start_us = now;
+	fade_contrast = start;
+	fade_pending = true;
+	fade_active = true;
+	taskEXIT_CRITICAL(&fade_lock);
+}
+
+bool u8g2_esp32_fade_is_active(void)
+{
+	bool is_active;
+
+	taskENTER_CRITICAL(&fade_lock);
+	is_active = fade_active;
+	taskEXIT_CRITICAL(&fade_lock);
+	return is_active;
+}
+
+// Calculate the contrast of a running fade, returns true if a new contrast has to be sent
+static bool fade_get_pending(uint8_t *contrast)
+{
+	int64_t now = esp_timer_get_time();
+	bool is_pending;
+
+	taskENTER_CRITICAL(&fade_lock);
+	if (fade_active)
+	{
+		uint8_t c = fade_calc_contrast(now);
+		if (c != fade_contrast)
+		{
+			fade_contrast = c;
+			fade_pending = true;
+		}
+	}
+	is_pending = fade_pending;
+	fade_pending = false;
+	*contrast = fade_contrast;
+	taskEXIT_CRITICAL(&fade_lock);
+	return is_pending;
+}
+
+/*
+ * Send the buffer and a pending contrast of the fade engine.
+ * With the I2C byte callback, all transfers of the frame, including the contrast
+ * command, are collected in one command link and executed with one i2c_master_cmd_begin().
+ * Returns the error of the first failed I2C transfer, the rest of the frame is not sent
+ * and the contrast stays pending. The frame has to be sent again.
+ */
+esp_err_t u8g2_esp32_send_buffer(u8g2_t *u8g2)
+{
+	uint8_t contrast;
+	bool is_contrast;
+	bool is_i2c = u8g2_GetU8x8(u8g2)->byte_cb == u8g2_esp32_i2c_byte_cb;
+	esp_err_t rc;
+
+	i2c_batch = is_i2c;
+	i2c_err = ESP_OK;
+	is_contrast = fade_get_pending(&contrast);
+	if (is_contrast)
+	{
+		u8g2_SetContrast(u8g2, contrast);
+	}
+	u8g2_SendBuffer(u8g2);
+	if (is_i2c)
+	{
+		i2c_execute();
+	}
+	i2c_batch = false;
+	rc = i2c_err;
+	if (rc != ESP_OK && is_contrast)
+	{
+		taskENTER_CRITICAL(&fade_lock);
+		fade_pending = true;
+		taskEXIT_CRITICAL(&fade_lock);
+	}
+	return rc;
+}
+
+/*
+ * Send a pending contrast of the fade engine without a frame.
+ * Use this if the frame was not sent, because it did not change.
+ */
+void u8g2_esp32_fade_flush(u8g2_t *u8g2)
+{
+	uint8_t contrast;
+	if (fade_get_pending(&contrast))
+	{
+		u8g2_SetContrast(u8g2, contrast);
+	}
+}
+
+/*
+ * Allocate the display buffers after the u8g2_Setup_...() call. buf_list must
+ * have space for cnt pointers and must stay valid. Together with
+ * CONFIG_U8G2_USE_DYNAMIC_ALLOC, no static display buffer is linked.
+ */
+esp_err_t u8g2_esp32_alloc_buffers(u8g2_t *u8g2, uint8_t **buf_list, uint8_t cnt)
+{
+	size_t size = u8g2_GetBufferSize(u8g2);
+
+	for (uint8_t i = 0; i < cnt; i++)
+	{
+		buf_list[i] = heap_caps_aligned_alloc(U8G2_BUFFER_ALIGNMENT, size, MALLOC_CAP_DMA);
+		if (buf_list[i] == NULL)
+		{
+			ESP_LOGE(TAG, "no memory for display buffer %u (%u bytes)", (unsigned)i, (unsigned)size);
+			while (i > 0)
+			{
+				heap_caps_free(buf_list[--i]);
+			}
+			return ESP_ERR_NO_MEM;
+		}
+		memset(buf_list[i], 0, size);
+	}
+	if (!u8g2_SetBuffers(u8g2, buf_list, cnt))
+	{
+		return ESP_ERR_INVALID_ARG;
+	}
+	return ESP_OK;
+}
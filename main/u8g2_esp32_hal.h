@@ -22,6 +22,25 @@
 #define ACK_CHECK_EN 0x1			//  I2C master will check ack from slave
 #define ACK_CHECK_DIS 0x0			//  I2C master will not check ack from slave
 
+// Busy loop count per half clock period for u8x8_byte_sw_i2c_fast and u8x8_byte_4wire_sw_spi_fast.
+// 0 is the fastest possible toggle rate, increase the I2C value if the display does not keep up.
+#ifndef U8G2_ESP32_FAST_I2C_DELAY_CNT
+#define U8G2_ESP32_FAST_I2C_DELAY_CNT 4
+#endif
+#ifndef U8G2_ESP32_FAST_SPI_DELAY_CNT
+#define U8G2_ESP32_FAST_SPI_DELAY_CNT 0
+#endif
+
+// Static memory of the I2C byte callback: Bytes and number of I2C transfers, which are
+// collected before they are executed. A 128x64 frame of the ssd13xx fast I2C cad has
+// 1248 bytes in 64 transfers. Larger frames are executed in several parts.
+#ifndef U8G2_ESP32_I2C_BUF_SIZE
+#define U8G2_ESP32_I2C_BUF_SIZE 1536
+#endif
+#ifndef U8G2_ESP32_I2C_MAX_TRANSFERS
+#define U8G2_ESP32_I2C_MAX_TRANSFERS 96
+#endif
+
 typedef struct
 {
 	gpio_num_t clk;
@@ -35,8 +54,25 @@ typedef struct
 
 #define U8G2_ESP32_HAL_DEFAULT {U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED, U8G2_ESP32_HAL_UNDEFINED}
 
+typedef enum
+{
+	U8G2_ESP32_FADE_LINEAR,
+	U8G2_ESP32_FADE_EASE_IN,
+	U8G2_ESP32_FADE_EASE_OUT,
+	U8G2_ESP32_FADE_EASE_IN_OUT,
+} u8g2_esp32_fade_easing_t;
+
 void u8g2_esp32_hal_init(u8g2_esp32_hal_t u8g2_esp32_hal_param);
 uint8_t u8g2_esp32_spi_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8g2_esp32_i2c_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8g2_esp32_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+// Contrast fade engine, the contrast is sent with the next u8g2_esp32_send_buffer()
+void u8g2_esp32_fade_start(uint8_t start, uint8_t end, uint32_t duration_ms, u8g2_esp32_fade_easing_t easing);
+bool u8g2_esp32_fade_is_active(void);
+void u8g2_esp32_fade_flush(u8g2_t *u8g2);
+esp_err_t u8g2_esp32_send_buffer(u8g2_t *u8g2);
+
+// Allocate cnt display buffers from DMA capable memory and assign them with u8g2_SetBuffers()
+esp_err_t u8g2_esp32_alloc_buffers(u8g2_t *u8g2, uint8_t **buf_list, uint8_t cnt);
 #endif /* U8G2_ESP32_HAL_H_ */